@@ -0,0 +1,481 @@
+#include "engine.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =====================================
+// Software Audio Mixer Implementation
+// =====================================
+
+// Mono 16-bit sample data registered before the mixer starts
+typedef struct {
+    const short* samples;
+    int frameCount;
+    AudioSoundSettings settings;
+    long long retriggerFrames;
+    long long lastStartFrame;      // Mixer clock of the newest instance (mixer only)
+    int activeVoices;              // Mixer only
+} AudioSound;
+
+// One playing instance of a sound
+typedef struct {
+    int sound;
+    int position;
+    float volume;
+    long long startFrame;          // Mixer clock when the voice started, for stealing
+    Vector3 worldPosition;         // Source position for positional voices
+    float gainLeft;                // Channel gains reached at the end of the last block
+    float gainRight;
+    bool positional;
+    bool active;
+} AudioVoice;
+
+// Request from the game thread to the mixer
+typedef struct {
+    int sound;
+    float volume;
+    Vector3 position;
+    bool positional;
+} AudioCommand;
+
+// Where the mixer hears from: the camera target, with the camera's right vector for panning
+typedef struct {
+    Vector3 position;
+    Vector3 right;
+} AudioListener;
+
+// Sound table: written only before Audio_Start(), read-only afterwards
+static AudioSound sounds[AUDIO_MAX_SOUNDS];
+static int soundCount = 0;
+
+// Owned by the mixer (whichever thread renders the blocks)
+static AudioVoice voices[AUDIO_MAX_VOICES];
+static float mixLeft[AUDIO_BUFFER_FRAMES];
+static float mixRight[AUDIO_BUFFER_FRAMES];
+static long long mixerFrame = 0;        // Frames rendered since Audio_Start()
+
+// Single-producer single-consumer ring: the game thread advances the head,
+// the mixer advances the tail; both are free-running and masked on access
+static AudioCommand queue[AUDIO_QUEUE_SIZE];
+static unsigned int queueHead = 0;
+static unsigned int queueTail = 0;
+
+// Listener triple buffer: the game thread fills listeners[listenerWrite] and
+// swaps it into listenerShared; the mixer swaps the newest one out into
+// listenerRead. LISTENER_FRESH marks a slot the mixer has not picked up yet.
+#define LISTENER_FRESH 4u
+static AudioListener listeners[3];
+static unsigned int listenerShared = 1;
+static unsigned int listenerWrite = 0;  // Game thread only
+static unsigned int listenerRead = 2;   // Mixer only
+
+// Optional source mixed under the effects (the music)
+static AudioMixCallback mixCallback = NULL;
+
+// CPU cost accumulated by the mixer and collected by Audio_GetStats()
+static long long statRenderNs = 0;
+static long long statCallbackNs = 0;
+static long long statFrames = 0;
+static int statPeakLoad = 0;            // Parts per 10000
+
+static AudioSinkType sinkType = AUDIO_SINK_NULL;
+static bool started = false;
+static int running = 0;                 // Cleared to stop the sink thread
+static UtilsThread* sinkThread = NULL;
+static AudioStream stream;
+static FILE* wavFile = NULL;
+static long long wavFrames = 0;
+
+int Audio_AddSound(const short* samples, int frameCount, const AudioSoundSettings* settings) {
+    if (started || !samples || frameCount <= 0 || !settings || soundCount >= AUDIO_MAX_SOUNDS) {
+        return -1;
+    }
+
+    AudioSound* sound = &sounds[soundCount];
+    sound->samples = samples;
+    sound->frameCount = frameCount;
+    sound->settings = *settings;
+    if (sound->settings.maxVoices < 1) sound->settings.maxVoices = 1;
+    sound->retriggerFrames = (long long)(settings->retriggerInterval * AUDIO_SAMPLE_RATE);
+    return soundCount++;
+}
+
+static void Audio_PushCommand(AudioCommand command) {
+    if (!started || command.sound < 0 || command.sound >= soundCount) return;
+
+    unsigned int head = __atomic_load_n(&queueHead, __ATOMIC_RELAXED);
+    unsigned int tail = __atomic_load_n(&queueTail, __ATOMIC_ACQUIRE);
+    if (head - tail >= AUDIO_QUEUE_SIZE) return;  // Mixer is behind; drop the request
+
+    queue[head & (AUDIO_QUEUE_SIZE - 1)] = command;
+    __atomic_store_n(&queueHead, head + 1, __ATOMIC_RELEASE);
+}
+
+void Audio_Play(int sound, float volume) {
+    Audio_PushCommand((AudioCommand){ sound, volume, { 0.0f, 0.0f, 0.0f }, false });
+}
+
+void Audio_PlayAt(int sound, float volume, Vector3 position) {
+    Audio_PushCommand((AudioCommand){ sound, volume, position, true });
+}
+
+void Audio_SetListener(const Camera3D* camera) {
+    if (!started || !camera) return;
+
+    // Only the orientation matters for panning; the game looks down at the target
+    Vector3 forward = Vector3Subtract(camera->target, camera->position);
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera->up));
+
+    listeners[listenerWrite] = (AudioListener){ camera->target, right };
+    listenerWrite = __atomic_exchange_n(&listenerShared, listenerWrite | LISTENER_FRESH, __ATOMIC_ACQ_REL) & 3u;
+}
+
+// Newest listener published by the game thread
+static const AudioListener* Audio_GetListener(void) {
+    if (__atomic_load_n(&listenerShared, __ATOMIC_RELAXED) & LISTENER_FRESH) {
+        listenerRead = __atomic_exchange_n(&listenerShared, listenerRead, __ATOMIC_ACQ_REL) & 3u;
+    }
+    return &listeners[listenerRead];
+}
+
+// Channel gains for a voice: inverse-distance attenuation and a balance pan
+// that narrows towards the centre inside the reference distance
+static void Audio_Spatialize(const AudioVoice* voice, const AudioListener* listener, float* left, float* right) {
+    if (!voice->positional) {
+        *left = *right = voice->volume;
+        return;
+    }
+
+    Vector3 offset = Vector3Subtract(voice->worldPosition, listener->position);
+    float distance = Vector3Length(offset);
+    float beyond = fmaxf(distance - AUDIO_REFERENCE_DISTANCE, 0.0f);
+    float gain = voice->volume * AUDIO_REFERENCE_DISTANCE / (AUDIO_REFERENCE_DISTANCE + AUDIO_ROLLOFF * beyond);
+    float pan = Vector3DotProduct(offset, listener->right) / fmaxf(distance, AUDIO_REFERENCE_DISTANCE);
+
+    *left = gain * fminf(1.0f - pan, 1.0f);
+    *right = gain * fminf(1.0f + pan, 1.0f);
+}
+
+// Pick the voice for a new instance of a sound, or -1 to drop the request
+static int Audio_AllocateVoice(int soundId) {
+    const AudioSound* sound = &sounds[soundId];
+    int oldestOwn = -1;
+    int idle = -1;
+    int victim = -1;
+
+    for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+        const AudioVoice* voice = &voices[i];
+        if (!voice->active) {
+            if (idle < 0) idle = i;
+            continue;
+        }
+
+        if (voice->sound == soundId) {
+            if (oldestOwn < 0 || voice->startFrame < voices[oldestOwn].startFrame) oldestOwn = i;
+        }
+
+        // Steal from the lowest priority first, then the oldest
+        int priority = sounds[voice->sound].settings.priority;
+        if (priority <= sound->settings.priority) {
+            if (victim < 0) {
+                victim = i;
+            } else {
+                int victimPriority = sounds[voices[victim].sound].settings.priority;
+                if (priority < victimPriority ||
+                    (priority == victimPriority && voice->startFrame < voices[victim].startFrame)) {
+                    victim = i;
+                }
+            }
+        }
+    }
+
+    // At its instance limit a sound restarts its own oldest voice
+    if (sound->activeVoices >= sound->settings.maxVoices) return oldestOwn;
+    return (idle >= 0) ? idle : victim;
+}
+
+static void Audio_StopVoice(AudioVoice* voice) {
+    if (!voice->active) return;
+    sounds[voice->sound].activeVoices--;
+    voice->active = false;
+}
+
+// Start voices for everything queued since the last block
+static void Audio_DrainQueue(const AudioListener* listener) {
+    unsigned int tail = __atomic_load_n(&queueTail, __ATOMIC_RELAXED);
+    unsigned int head = __atomic_load_n(&queueHead, __ATOMIC_ACQUIRE);
+
+    for (; tail != head; tail++) {
+        AudioCommand command = queue[tail & (AUDIO_QUEUE_SIZE - 1)];
+        AudioSound* sound = &sounds[command.sound];
+
+        // Rapid retriggers (e.g. turn ticks every frame) collapse into one
+        if (mixerFrame - sound->lastStartFrame < sound->retriggerFrames) continue;
+
+        int index = Audio_AllocateVoice(command.sound);
+        if (index < 0) continue;
+
+        AudioVoice* voice = &voices[index];
+        Audio_StopVoice(voice);
+        voice->sound = command.sound;
+        voice->position = 0;
+        voice->volume = command.volume * sound->settings.volume;
+        voice->startFrame = mixerFrame;
+        voice->worldPosition = command.position;
+        voice->positional = command.positional;
+        voice->active = true;
+
+        // Start at the spatialized gains rather than ramping up from silence
+        Audio_Spatialize(voice, listener, &voice->gainLeft, &voice->gainRight);
+        sound->activeVoices++;
+        sound->lastStartFrame = mixerFrame;
+    }
+
+    __atomic_store_n(&queueTail, tail, __ATOMIC_RELEASE);
+}
+
+// Branchless clamp to the 16-bit range, so the output loop vectorizes
+static inline float Audio_ClampSample(float sample) {
+    return 0.5f * (fabsf(sample + 32768.0f) - fabsf(sample - 32767.0f) - 1.0f);
+}
+
+// Mix one block of active voices into interleaved 16-bit stereo output
+static void Audio_Render(short* output, int frames) {
+    if (frames <= 0) return;
+    PROFILE_BEGIN("Audio_Render");
+
+    long long startNs = Utils_GetTimeNs();
+    long long callbackNs = 0;
+    int totalFrames = frames;
+
+    const AudioListener* listener = Audio_GetListener();
+    Audio_DrainQueue(listener);
+
+    while (frames > 0) {
+        int count = frames < AUDIO_BUFFER_FRAMES ? frames : AUDIO_BUFFER_FRAMES;
+        memset(mixLeft, 0, sizeof(float) * count);
+        memset(mixRight, 0, sizeof(float) * count);
+
+        if (mixCallback) {
+            long long callbackStartNs = Utils_GetTimeNs();
+            mixCallback(mixLeft, mixRight, count);
+            callbackNs += Utils_GetTimeNs() - callbackStartNs;
+        }
+
+        for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+            AudioVoice* voice = &voices[i];
+            if (!voice->active) continue;
+
+            const AudioSound* sound = &sounds[voice->sound];
+            int remaining = sound->frameCount - voice->position;
+            int length = remaining < count ? remaining : count;
+            const short* source = sound->samples + voice->position;
+
+            // Ramp from last block's gains to this block's so moving sources don't click
+            float targetLeft, targetRight;
+            Audio_Spatialize(voice, listener, &targetLeft, &targetRight);
+            float left = voice->gainLeft;
+            float right = voice->gainRight;
+            float stepLeft = (targetLeft - left) / count;
+            float stepRight = (targetRight - right) / count;
+
+            for (int j = 0; j < length; j++) {
+                float sample = source[j];
+                mixLeft[j] += sample * (left + stepLeft * j);
+                mixRight[j] += sample * (right + stepRight * j);
+            }
+
+            voice->gainLeft = targetLeft;
+            voice->gainRight = targetRight;
+            voice->position += length;
+            if (voice->position >= sound->frameCount) Audio_StopVoice(voice);
+        }
+
+        for (int j = 0; j < count; j++) {
+            output[2 * j] = (short)Audio_ClampSample(mixLeft[j]);
+            output[2 * j + 1] = (short)Audio_ClampSample(mixRight[j]);
+        }
+
+        output += count * AUDIO_CHANNELS;
+        frames -= count;
+        mixerFrame += count;
+    }
+
+    long long renderNs = Utils_GetTimeNs() - startNs;
+    __atomic_fetch_add(&statRenderNs, renderNs, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&statCallbackNs, callbackNs, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&statFrames, totalFrames, __ATOMIC_RELAXED);
+
+    // Render time as a share of the real time the block lasts
+    int load = (int)(renderNs * AUDIO_SAMPLE_RATE / 100000LL / totalFrames);
+    if (load > __atomic_load_n(&statPeakLoad, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&statPeakLoad, load, __ATOMIC_RELAXED);
+    }
+    PROFILE_END();
+}
+
+// Called by raylib's audio device thread
+static void Audio_StreamCallback(void* bufferData, unsigned int frames) {
+    Audio_Render((short*)bufferData, (int)frames);
+}
+
+static void Audio_WriteWavHeader(FILE* file, long long frames) {
+    unsigned int dataBytes = (unsigned int)(frames * AUDIO_CHANNELS * sizeof(short));
+    unsigned int riffBytes = 36 + dataBytes;
+    unsigned int formatBytes = 16;
+    unsigned short format = 1;  // PCM
+    unsigned short channels = AUDIO_CHANNELS;
+    unsigned int sampleRate = AUDIO_SAMPLE_RATE;
+    unsigned int byteRate = AUDIO_SAMPLE_RATE * AUDIO_CHANNELS * sizeof(short);
+    unsigned short blockAlign = AUDIO_CHANNELS * sizeof(short);
+    unsigned short bitsPerSample = 16;
+
+    fseek(file, 0, SEEK_SET);
+    fwrite("RIFF", 1, 4, file);
+    fwrite(&riffBytes, 4, 1, file);
+    fwrite("WAVEfmt ", 1, 8, file);
+    fwrite(&formatBytes, 4, 1, file);
+    fwrite(&format, 2, 1, file);
+    fwrite(&channels, 2, 1, file);
+    fwrite(&sampleRate, 4, 1, file);
+    fwrite(&byteRate, 4, 1, file);
+    fwrite(&blockAlign, 2, 1, file);
+    fwrite(&bitsPerSample, 2, 1, file);
+    fwrite("data", 1, 4, file);
+    fwrite(&dataBytes, 4, 1, file);
+}
+
+// Mixer thread for the WAV and null sinks, paced to real time
+static void Audio_SinkThread(void* arg) {
+    (void)arg;
+    short block[AUDIO_BUFFER_FRAMES * AUDIO_CHANNELS];
+    const long long blockNs = (long long)AUDIO_BUFFER_FRAMES * 1000000000LL / AUDIO_SAMPLE_RATE;
+    long long nextNs = Utils_GetTimeNs();
+
+    while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+        PROFILE_BEGIN("Audio_SinkThread");
+        Audio_Render(block, AUDIO_BUFFER_FRAMES);
+
+        if (wavFile) {
+            fwrite(block, sizeof(short), AUDIO_BUFFER_FRAMES * AUDIO_CHANNELS, wavFile);
+            wavFrames += AUDIO_BUFFER_FRAMES;
+        }
+        PROFILE_END();
+
+        // Sleep against an absolute schedule so blocks don't drift
+        nextNs += blockNs;
+        long long waitNs = nextNs - Utils_GetTimeNs();
+        if (waitNs > 0) WaitTime(waitNs / 1000000000.0);
+    }
+}
+
+bool Audio_Start(AudioSinkType sink, const char* wavPath) {
+    if (started) return false;
+
+    memset(voices, 0, sizeof(voices));
+    for (int i = 0; i < soundCount; i++) {
+        sounds[i].activeVoices = 0;
+        sounds[i].lastStartFrame = -sounds[i].retriggerFrames;
+    }
+    queueHead = queueTail = 0;
+    mixerFrame = 0;
+
+    // Default listener at the origin until the game publishes the camera
+    for (int i = 0; i < 3; i++) {
+        listeners[i] = (AudioListener){ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } };
+    }
+    listenerWrite = 0;
+    listenerShared = 1;
+    listenerRead = 2;
+
+    if (sink == AUDIO_SINK_STREAM) {
+        InitAudioDevice();
+        if (IsAudioDeviceReady()) {
+            SetAudioStreamBufferSizeDefault(AUDIO_BUFFER_FRAMES);
+            stream = LoadAudioStream(AUDIO_SAMPLE_RATE, 16, AUDIO_CHANNELS);
+            SetAudioStreamCallback(stream, Audio_StreamCallback);
+            PlayAudioStream(stream);
+            sinkType = AUDIO_SINK_STREAM;
+            started = true;
+            return true;
+        }
+
+        // No device: keep consuming commands so the game behaves the same
+        TraceLog(LOG_WARNING, "Audio: device not available, mixing to %s", wavPath ? wavPath : "nothing");
+        sink = wavPath ? AUDIO_SINK_WAV : AUDIO_SINK_NULL;
+    }
+
+    if (sink == AUDIO_SINK_WAV) {
+        wavFile = wavPath ? fopen(wavPath, "wb") : NULL;
+        if (wavFile) {
+            wavFrames = 0;
+            Audio_WriteWavHeader(wavFile, 0);
+        } else {
+            TraceLog(LOG_WARNING, "Audio: could not open %s, using the null sink", wavPath ? wavPath : "(none)");
+            sink = AUDIO_SINK_NULL;
+        }
+    }
+
+    sinkType = sink;
+    started = true;
+    running = 1;
+    sinkThread = Utils_StartThread(Audio_SinkThread, NULL);
+    if (!sinkThread) {
+        TraceLog(LOG_WARNING, "Audio: could not start the mixer thread");
+        running = 0;
+        started = false;
+        if (wavFile) {
+            fclose(wavFile);
+            wavFile = NULL;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+void Audio_SetMixCallback(AudioMixCallback callback) {
+    if (!started) mixCallback = callback;
+}
+
+void Audio_GetStats(AudioStats* stats) {
+    long long renderNs = __atomic_exchange_n(&statRenderNs, 0, __ATOMIC_RELAXED);
+    long long callbackNs = __atomic_exchange_n(&statCallbackNs, 0, __ATOMIC_RELAXED);
+    long long frames = __atomic_exchange_n(&statFrames, 0, __ATOMIC_RELAXED);
+    int peakLoad = __atomic_exchange_n(&statPeakLoad, 0, __ATOMIC_RELAXED);
+
+    // Normalized to one AUDIO_BUFFER_FRAMES block, whatever size the device asks for
+    double blocks = frames > 0 ? (double)frames / AUDIO_BUFFER_FRAMES : 1.0;
+    stats->mixMs = renderNs / 1000000.0 / blocks;
+    stats->callbackMs = callbackNs / 1000000.0 / blocks;
+    stats->peakLoad = peakLoad / 10000.0;
+}
+
+AudioSinkType Audio_GetSink(void) {
+    return sinkType;
+}
+
+void Audio_Shutdown(void) {
+    if (started) {
+        if (sinkType == AUDIO_SINK_STREAM) {
+            StopAudioStream(stream);
+            UnloadAudioStream(stream);
+            CloseAudioDevice();
+        } else {
+            __atomic_store_n(&running, 0, __ATOMIC_RELEASE);
+            Utils_JoinThread(sinkThread);
+            sinkThread = NULL;
+        }
+
+        if (wavFile) {
+            Audio_WriteWavHeader(wavFile, wavFrames);
+            fclose(wavFile);
+            wavFile = NULL;
+        }
+        started = false;
+    }
+
+    soundCount = 0;
+    mixCallback = NULL;
+}
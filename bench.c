@@ -0,0 +1,356 @@
+// Windowless micro-benchmarks for engine and game hot paths (make bench)
+//
+// The game code is pulled in directly so its types and functions can be
+// driven without a window; its main() is compiled out.
+#define SPACE_IS_LEFT_NO_MAIN
+#define MAX_SEGMENTS 5000
+#include "main.c"
+
+// =====================================
+// Benchmark Harness
+// =====================================
+
+#define BENCH_WARMUP_TRIALS 5
+#define BENCH_TRIALS 31
+
+// One benchmark: setup runs untimed before every trial, run does `iterations` operations
+typedef struct {
+    const char* name;
+    int n;                         // Problem size reported with the result
+    int iterations;                // Operations per timed trial
+    void (*setup)(void* context);
+    void (*run)(void* context, int iterations);
+    void* context;
+} Benchmark;
+
+static int Bench_CompareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double Bench_Median(double* values, int count) {
+    qsort(values, count, sizeof(double), Bench_CompareDoubles);
+    return (count % 2) ? values[count / 2] : 0.5 * (values[count / 2 - 1] + values[count / 2]);
+}
+
+// Prints one line per benchmark:
+// BENCH name=<name> n=<size> median_ns=<per op> mad_ns=<per op> trials=<count>
+static void Bench_Run(const Benchmark* bench) {
+    double samples[BENCH_TRIALS];
+    double deviations[BENCH_TRIALS];
+
+    for (int trial = 0; trial < BENCH_WARMUP_TRIALS + BENCH_TRIALS; trial++) {
+        if (bench->setup) bench->setup(bench->context);
+
+        long long start = Utils_GetTimeNs();
+        bench->run(bench->context, bench->iterations);
+        long long elapsed = Utils_GetTimeNs() - start;
+
+        if (trial >= BENCH_WARMUP_TRIALS) {
+            samples[trial - BENCH_WARMUP_TRIALS] = (double)elapsed / bench->iterations;
+        }
+    }
+
+    // Median and median absolute deviation are robust to scheduler noise
+    double median = Bench_Median(samples, BENCH_TRIALS);
+    for (int i = 0; i < BENCH_TRIALS; i++) {
+        deviations[i] = fabs(samples[i] - median);
+    }
+    double mad = Bench_Median(deviations, BENCH_TRIALS);
+
+    printf("BENCH name=%s n=%d median_ns=%.1f mad_ns=%.1f trials=%d\n",
+           bench->name, bench->n, median, mad, BENCH_TRIALS);
+    fflush(stdout);
+}
+
+// =====================================
+// Engine Benchmarks
+// =====================================
+
+typedef struct {
+    EngineState* engine;
+    int n;
+    int ids[MAX_ENTITIES];
+} EntityContext;
+
+// Fill the entity table with n cubes scattered over the arena
+static void Bench_FillEntities(EntityContext* ctx) {
+    EngineState* engine = ctx->engine;
+    Entity_ResetAll(engine);
+
+    for (int i = 0; i < ctx->n; i++) {
+        Entity* entity = Entity_Create(engine, ENTITY_TYPE_UNIT);
+        Entity_SetPosition(engine, entity, (Vector3){
+            (float)(rand() % 100 - 50), 0.5f, (float)(rand() % 100 - 50)
+        });
+        ctx->ids[i] = entity->id;
+    }
+}
+
+static void Bench_SetupEntities(void* context) {
+    Bench_FillEntities((EntityContext*)context);
+}
+
+static void Bench_EntityChurn(void* context, int iterations) {
+    EntityContext* ctx = (EntityContext*)context;
+    for (int i = 0; i < iterations; i++) {
+        Entity* entity = Entity_Create(ctx->engine, ENTITY_TYPE_UNIT);
+        Entity_Destroy(ctx->engine, entity->id);
+    }
+}
+
+static void Bench_EntityGetById(void* context, int iterations) {
+    EntityContext* ctx = (EntityContext*)context;
+    volatile int found = 0;
+    for (int i = 0; i < iterations; i++) {
+        found += Entity_GetById(ctx->engine, ctx->ids[(i * 7919) % ctx->n]) != NULL;
+    }
+    (void)found;
+}
+
+static void Bench_EntitySelectInBox(void* context, int iterations) {
+    EntityContext* ctx = (EntityContext*)context;
+    Vector2 start = { ctx->engine->windowWidth * 0.25f, ctx->engine->windowHeight * 0.25f };
+    Vector2 end = { ctx->engine->windowWidth * 0.75f, ctx->engine->windowHeight * 0.75f };
+    for (int i = 0; i < iterations; i++) {
+        Entity_SelectInBox(ctx->engine, start, end, SELECT_REPLACE);
+    }
+}
+
+// Cursor swept over the canvas in 64 steps, as hover picking does while the mouse moves
+static void Bench_EntityPick(void* context, int iterations) {
+    EntityContext* ctx = (EntityContext*)context;
+    volatile int found = 0;
+    for (int i = 0; i < iterations; i++) {
+        Vector2 cursor = {
+            ctx->engine->windowWidth * ((i % 8) + 0.5f) / 8.0f,
+            ctx->engine->windowHeight * (((i / 8) % 8) + 0.5f) / 8.0f
+        };
+        found += Entity_Pick(ctx->engine, cursor) != NULL;
+    }
+    (void)found;
+}
+
+#define BENCH_PROJECTED_POINTS 4096
+
+typedef struct {
+    EngineState* engine;
+    Vector3 points[BENCH_PROJECTED_POINTS];
+    Vector2 screen[BENCH_PROJECTED_POINTS];
+} ProjectionContext;
+
+static void Bench_WorldToScreen(void* context, int iterations) {
+    ProjectionContext* ctx = (ProjectionContext*)context;
+    for (int i = 0; i < iterations; i++) {
+        for (int p = 0; p < BENCH_PROJECTED_POINTS; p++) {
+            ctx->screen[p] = GetWorldToScreenEx(ctx->points[p], ctx->engine->camera,
+                                                ctx->engine->windowWidth, ctx->engine->windowHeight);
+        }
+    }
+}
+
+static void Bench_WorldToScreenBatch(void* context, int iterations) {
+    ProjectionContext* ctx = (ProjectionContext*)context;
+    for (int i = 0; i < iterations; i++) {
+        Utils_WorldToScreenBatch(ctx->engine, ctx->points, BENCH_PROJECTED_POINTS, ctx->screen);
+    }
+}
+
+#define BENCH_COLLISION_PAIRS 1024
+
+typedef struct {
+    Vector3 positions[BENCH_COLLISION_PAIRS * 2];
+    BoundingBox boxes[BENCH_COLLISION_PAIRS * 2];
+} CollisionContext;
+
+static void Bench_CollisionSpheres(void* context, int iterations) {
+    CollisionContext* ctx = (CollisionContext*)context;
+    volatile int hits = 0;
+    for (int i = 0; i < iterations; i++) {
+        int pair = i % BENCH_COLLISION_PAIRS;
+        hits += Utils_CheckCollisionSpheres(ctx->positions[pair * 2], 1.0f, ctx->positions[pair * 2 + 1], 1.0f);
+    }
+    (void)hits;
+}
+
+static void Bench_CollisionBoxes(void* context, int iterations) {
+    CollisionContext* ctx = (CollisionContext*)context;
+    volatile int hits = 0;
+    for (int i = 0; i < iterations; i++) {
+        int pair = i % BENCH_COLLISION_PAIRS;
+        hits += Utils_CheckCollisionBoxes(ctx->boxes[pair * 2], ctx->boxes[pair * 2 + 1]);
+    }
+    (void)hits;
+}
+
+// =====================================
+// Game Benchmarks
+// =====================================
+
+typedef struct {
+    GameState* game;
+    EngineState* engine;
+    LineRider snapshot;            // Rider restored before every trial
+} GameContext;
+
+// A rider of n segments in a straight line, heading away from its body
+static void Bench_BuildRider(GameContext* ctx, int segments) {
+    GameState* game = ctx->game;
+    game->difficultyMultiplier = 1.0f;
+    game->slowTimeMultiplier = 1.0f;
+    InitLineRider(game);
+
+    LineRider* rider = &game->rider;
+    rider->segmentCount = segments;
+    rider->shieldTimer = 1000.0f;  // Never die mid-benchmark
+    for (int i = 0; i < segments; i++) {
+        rider->segments[i] = rider->segments[i % INITIAL_SEGMENTS];
+        rider->segments[i].position = (Vector3){ 0, 0.5f, -i * SEGMENT_SPACING };
+        rider->segments[i].previousPos = rider->segments[i].position;
+        rider->segments[i].isHead = (i == 0);
+    }
+    ctx->snapshot = *rider;
+}
+
+static void Bench_SetupRider(void* context) {
+    GameContext* ctx = (GameContext*)context;
+    ctx->game->rider = ctx->snapshot;
+    memset(ctx->game->particles, 0, sizeof(ctx->game->particles));
+}
+
+static void Bench_UpdateLineRider(void* context, int iterations) {
+    GameContext* ctx = (GameContext*)context;
+    for (int i = 0; i < iterations; i++) {
+        UpdateLineRider(ctx->game, ctx->engine);
+    }
+}
+
+static void Bench_SetupEmptyParticles(void* context) {
+    GameContext* ctx = (GameContext*)context;
+    memset(ctx->game->particles, 0, sizeof(ctx->game->particles));
+}
+
+static void Bench_SpawnParticles(void* context, int iterations) {
+    GameContext* ctx = (GameContext*)context;
+    for (int i = 0; i < iterations; i++) {
+        // Expire the pool so every call finds free slots
+        for (int j = 0; j < PARTICLE_COUNT; j++) ctx->game->particles[j].lifetime = 0;
+        SpawnParticles(ctx->game, (Vector3){0, 0, 0}, GOLD, PARTICLE_COUNT);
+    }
+}
+
+static void Bench_SetupFullParticles(void* context) {
+    GameContext* ctx = (GameContext*)context;
+    memset(ctx->game->particles, 0, sizeof(ctx->game->particles));
+    SpawnParticles(ctx->game, (Vector3){0, 0, 0}, GOLD, PARTICLE_COUNT);
+    for (int j = 0; j < PARTICLE_COUNT; j++) ctx->game->particles[j].lifetime = 1000.0f;
+}
+
+static void Bench_UpdateParticles(void* context, int iterations) {
+    GameContext* ctx = (GameContext*)context;
+    for (int i = 0; i < iterations; i++) {
+        UpdateParticles(ctx->game, 1.0f / 60.0f);
+    }
+}
+
+static void Bench_SynthRender(void* context, int iterations) {
+    const SynthParams* params = (const SynthParams*)context;
+    static short output[AUDIO_SAMPLE_RATE];  // Up to one second
+    for (int i = 0; i < iterations; i++) {
+        Synth_Render(params, output);
+    }
+}
+
+// =====================================
+// Benchmark Entry Point
+// =====================================
+
+int main(void) {
+    // Deterministic inputs and no raylib log noise
+    srand(1);
+    SetTraceLogLevel(LOG_WARNING);
+
+    EngineState* engine = (EngineState*)calloc(1, sizeof(EngineState));
+    GameState* game = (GameState*)calloc(1, sizeof(GameState));
+    EntityContext* entities = (EntityContext*)calloc(1, sizeof(EntityContext));
+    CollisionContext* collisions = (CollisionContext*)calloc(1, sizeof(CollisionContext));
+    ProjectionContext* projection = (ProjectionContext*)calloc(1, sizeof(ProjectionContext));
+    if (!engine || !game || !entities || !collisions || !projection) {
+        printf("Failed to allocate benchmark state!\n");
+        return 1;
+    }
+
+    // Same camera and canvas the game starts with, without opening a window
+    engine->windowWidth = DEFAULT_WINDOW_WIDTH;
+    engine->windowHeight = DEFAULT_WINDOW_HEIGHT;
+    engine->deltaTime = 1.0f / DEFAULT_FPS;
+    engine->activeGamepad = -1;
+    engine->camera.position = (Vector3){ 0.0f, 45.0f, 45.0f };
+    engine->camera.target = (Vector3){ 0.0f, 0.0f, 0.0f };
+    engine->camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    engine->camera.fovy = 60.0f;
+    engine->camera.projection = CAMERA_PERSPECTIVE;
+    Camera_Apply(engine);
+
+    printf("# %s %s micro-benchmarks, build %s\n", ENGINE_NAME, ENGINE_VERSION, BUILD_ID);
+
+    // Entity system
+    entities->engine = engine;
+    entities->n = MAX_ENTITIES / 2;
+    Bench_FillEntities(entities);
+    Bench_Run(&(Benchmark){ "entity_create_destroy", entities->n, 1000, NULL, Bench_EntityChurn, entities });
+    Bench_Run(&(Benchmark){ "entity_get_by_id", entities->n, 1000, NULL, Bench_EntityGetById, entities });
+
+    int selectSizes[] = { 100, MAX_ENTITIES };
+    for (int i = 0; i < 2; i++) {
+        entities->n = selectSizes[i];
+        Bench_Run(&(Benchmark){ "entity_select_in_box", entities->n, 10, Bench_SetupEntities,
+                                Bench_EntitySelectInBox, entities });
+        Bench_Run(&(Benchmark){ "entity_pick", entities->n, 64, NULL, Bench_EntityPick, entities });
+    }
+
+    // Camera projection, per point through raylib vs batched with the cached matrices
+    projection->engine = engine;
+    for (int i = 0; i < BENCH_PROJECTED_POINTS; i++) {
+        projection->points[i] = (Vector3){ (float)(rand() % 100 - 50), (float)(rand() % 10), (float)(rand() % 100 - 50) };
+    }
+    Bench_Run(&(Benchmark){ "world_to_screen", BENCH_PROJECTED_POINTS, 10, NULL, Bench_WorldToScreen, projection });
+    Bench_Run(&(Benchmark){ "world_to_screen_batch", BENCH_PROJECTED_POINTS, 10, NULL,
+                            Bench_WorldToScreenBatch, projection });
+
+    // Collision helpers
+    for (int i = 0; i < BENCH_COLLISION_PAIRS * 2; i++) {
+        Vector3 p = { (float)(rand() % 20), (float)(rand() % 20), (float)(rand() % 20) };
+        collisions->positions[i] = p;
+        collisions->boxes[i] = (BoundingBox){ Vector3Subtract(p, (Vector3){1, 1, 1}), Vector3Add(p, (Vector3){1, 1, 1}) };
+    }
+    Bench_Run(&(Benchmark){ "collision_spheres", BENCH_COLLISION_PAIRS, 100000, NULL, Bench_CollisionSpheres, collisions });
+    Bench_Run(&(Benchmark){ "collision_boxes", BENCH_COLLISION_PAIRS, 100000, NULL, Bench_CollisionBoxes, collisions });
+
+    // Game hot paths
+    static GameContext gameContext;  // Holds a 5000 segment rider snapshot
+    gameContext.game = game;
+    gameContext.engine = engine;
+    int riderSizes[] = { 5, 500, 5000 };
+    for (int i = 0; i < 3; i++) {
+        Bench_BuildRider(&gameContext, riderSizes[i]);
+        Bench_Run(&(Benchmark){ "update_line_rider", riderSizes[i], 60, Bench_SetupRider,
+                                Bench_UpdateLineRider, &gameContext });
+    }
+    Bench_Run(&(Benchmark){ "spawn_particles", PARTICLE_COUNT, 100, Bench_SetupEmptyParticles,
+                            Bench_SpawnParticles, &gameContext });
+    Bench_Run(&(Benchmark){ "update_particles", PARTICLE_COUNT, 1000, Bench_SetupFullParticles,
+                            Bench_UpdateParticles, &gameContext });
+    SynthParams* pickup = (SynthParams*)&soundEffectParams[SFX_PICKUP_ENERGY];
+    SynthParams* gameOver = (SynthParams*)&soundEffectParams[SFX_GAME_OVER];
+    Bench_Run(&(Benchmark){ "synth_render_plain", Synth_GetFrameCount(pickup), 20, NULL, Bench_SynthRender, pickup });
+    Bench_Run(&(Benchmark){ "synth_render_fm", Synth_GetFrameCount(gameOver), 20, NULL, Bench_SynthRender, gameOver });
+
+    free(projection);
+    free(collisions);
+    free(entities);
+    free(game);
+    free(engine);
+    return 0;
+}
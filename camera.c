@@ -1,4 +1,5 @@
 #include "engine.h"
+#include <rlgl.h>
 #include <math.h>
 
 // =====================================
@@ -34,12 +35,14 @@ void Camera_InitIsometric(IsometricCamera* cam, Vector3 target, float height) {
 
 void Camera_UpdateOrbit(EngineState* engine) {
     if (!engine) return;
+    PROFILE_BEGIN("Camera_UpdateOrbit");
     
     OrbitCamera* cam = &engine->orbitCamera;
+    const InputFrame* input = &engine->input;
     
     // Mouse rotation
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-        Vector2 mouseDelta = GetMouseDelta();
+    if (input->down[ACTION_CAMERA_ROTATE]) {
+        Vector2 mouseDelta = input->mouseDelta;
         cam->rotationH += mouseDelta.x * CAMERA_MOUSE_SENSITIVITY;
         cam->rotationV -= mouseDelta.y * CAMERA_MOUSE_SENSITIVITY;
         
@@ -49,21 +52,22 @@ void Camera_UpdateOrbit(EngineState* engine) {
     }
     
     // Gamepad rotation (right stick)
-    if (engine->activeGamepad >= 0) {
-        Vector2 rightStick = engine->gamepadRightStick[engine->activeGamepad];
-        if (fabsf(rightStick.x) > 0.1f || fabsf(rightStick.y) > 0.1f) {
-            cam->rotationH += rightStick.x * CAMERA_MOUSE_SENSITIVITY * 60.0f * engine->deltaTime;
-            cam->rotationV += rightStick.y * CAMERA_MOUSE_SENSITIVITY * 60.0f * engine->deltaTime;
-            
-            // Clamp vertical rotation
-            if (cam->rotationV < 0.1f) cam->rotationV = 0.1f;
-            if (cam->rotationV > PI - 0.1f) cam->rotationV = PI - 0.1f;
-        }
+    Vector2 look = {
+        input->value[ACTION_LOOK_RIGHT] - input->value[ACTION_LOOK_LEFT],
+        input->value[ACTION_LOOK_DOWN] - input->value[ACTION_LOOK_UP]
+    };
+    if (look.x != 0 || look.y != 0) {
+        cam->rotationH += look.x * CAMERA_MOUSE_SENSITIVITY * 60.0f * engine->deltaTime;
+        cam->rotationV += look.y * CAMERA_MOUSE_SENSITIVITY * 60.0f * engine->deltaTime;
+        
+        // Clamp vertical rotation
+        if (cam->rotationV < 0.1f) cam->rotationV = 0.1f;
+        if (cam->rotationV > PI - 0.1f) cam->rotationV = PI - 0.1f;
     }
     
     // Mouse pan
-    if (IsMouseButtonDown(MOUSE_MIDDLE_BUTTON)) {
-        Vector2 mouseDelta = GetMouseDelta();
+    if (input->down[ACTION_CAMERA_DRAG]) {
+        Vector2 mouseDelta = input->mouseDelta;
         
         Vector3 forward = Vector3Normalize(Vector3Subtract(engine->camera.target, engine->camera.position));
         Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, (Vector3){0, 1, 0}));
@@ -73,67 +77,40 @@ void Camera_UpdateOrbit(EngineState* engine) {
         cam->target = Vector3Add(cam->target, Vector3Scale(up, mouseDelta.y * 0.01f * cam->distance));
     }
     
-    // Gamepad pan (left stick or D-pad)
-    if (engine->activeGamepad >= 0) {
-        Vector2 leftStick = engine->gamepadLeftStick[engine->activeGamepad];
-        Vector2 panInput = {0, 0};
-        
-        // Left stick
-        if (fabsf(leftStick.x) > 0.1f || fabsf(leftStick.y) > 0.1f) {
-            panInput.x = leftStick.x;
-            panInput.y = leftStick.y;
-        }
-        
-        // D-pad
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_LEFT)) panInput.x -= 1.0f;
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_RIGHT)) panInput.x += 1.0f;
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_UP)) panInput.y -= 1.0f;
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN)) panInput.y += 1.0f;
+    // Pan actions (keys, left stick or D-pad)
+    Vector2 panInput = {
+        input->value[ACTION_PAN_RIGHT] - input->value[ACTION_PAN_LEFT],
+        input->value[ACTION_PAN_DOWN] - input->value[ACTION_PAN_UP]
+    };
+    if (panInput.x != 0 || panInput.y != 0) {
+        Vector3 forward = Vector3Normalize(Vector3Subtract(engine->camera.target, engine->camera.position));
+        Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, (Vector3){0, 1, 0}));
+        Vector3 up = Vector3CrossProduct(right, forward);
         
-        if (panInput.x != 0 || panInput.y != 0) {
-            Vector3 forward = Vector3Normalize(Vector3Subtract(engine->camera.target, engine->camera.position));
-            Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, (Vector3){0, 1, 0}));
-            Vector3 up = Vector3CrossProduct(right, forward);
-            
-            float panSpeed = cam->distance * 0.5f * engine->deltaTime;
-            cam->target = Vector3Add(cam->target, Vector3Scale(right, panInput.x * panSpeed));
-            cam->target = Vector3Add(cam->target, Vector3Scale(up, -panInput.y * panSpeed));
-        }
+        float panSpeed = cam->distance * 0.5f * engine->deltaTime;
+        cam->target = Vector3Add(cam->target, Vector3Scale(right, panInput.x * panSpeed));
+        cam->target = Vector3Add(cam->target, Vector3Scale(up, -panInput.y * panSpeed));
     }
     
     // Mouse zoom
-    float wheel = GetMouseWheelMove();
+    float wheel = input->mouseWheel;
     if (wheel != 0) {
         cam->distance -= wheel * cam->distance * CAMERA_ZOOM_SPEED;
         if (cam->distance < CAMERA_MIN_DISTANCE) cam->distance = CAMERA_MIN_DISTANCE;
         if (cam->distance > CAMERA_MAX_DISTANCE) cam->distance = CAMERA_MAX_DISTANCE;
     }
     
-    // Gamepad zoom (left bumper and left trigger only, or stick buttons)
-    if (engine->activeGamepad >= 0) {
-        float zoomInput = 0;
-        
-        // Use left bumper for zoom in, left trigger for zoom out (avoid right side which is used for steering)
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_TRIGGER_1)) zoomInput += 1.0f;
-        
-        // Use left trigger for zoom out (analog)
-        float leftTrigger = engine->gamepadLeftTrigger[engine->activeGamepad];
-        if (leftTrigger > 0.1f) zoomInput -= leftTrigger;
-        
-        // Alternative: Use stick buttons for zoom
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_THUMB)) zoomInput += 1.0f;   // L3 zoom in
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_THUMB)) zoomInput -= 1.0f;  // R3 zoom out
-        
-        if (zoomInput != 0) {
-            cam->distance -= zoomInput * cam->distance * CAMERA_ZOOM_SPEED * 3.0f * engine->deltaTime;
-            if (cam->distance < CAMERA_MIN_DISTANCE) cam->distance = CAMERA_MIN_DISTANCE;
-            if (cam->distance > CAMERA_MAX_DISTANCE) cam->distance = CAMERA_MAX_DISTANCE;
-        }
+    // Zoom actions (left bumper, left trigger and stick buttons by default,
+    // keeping the right side free for steering)
+    float zoomInput = input->value[ACTION_ZOOM_IN] - input->value[ACTION_ZOOM_OUT];
+    if (zoomInput != 0) {
+        cam->distance -= zoomInput * cam->distance * CAMERA_ZOOM_SPEED * 3.0f * engine->deltaTime;
+        if (cam->distance < CAMERA_MIN_DISTANCE) cam->distance = CAMERA_MIN_DISTANCE;
+        if (cam->distance > CAMERA_MAX_DISTANCE) cam->distance = CAMERA_MAX_DISTANCE;
     }
     
     // Reset camera (R key or gamepad Select button)
-    if (IsKeyPressed(KEY_R) || 
-        (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_MIDDLE_LEFT))) {
+    if (input->pressed[ACTION_CAMERA_RESET]) {
         cam->rotationH = PI * 0.25f;
         cam->rotationV = PI * 0.15f;
         cam->distance = 10.0f;
@@ -147,39 +124,27 @@ void Camera_UpdateOrbit(EngineState* engine) {
     
     engine->camera.position = Vector3Add(cam->target, (Vector3){x, y, z});
     engine->camera.target = cam->target;
+    
+    PROFILE_END();
 }
 
 void Camera_UpdateIsometric(EngineState* engine) {
     if (!engine) return;
+    PROFILE_BEGIN("Camera_UpdateIsometric");
     
     IsometricCamera* cam = &engine->isoCamera;
+    const InputFrame* input = &engine->input;
     float dt = engine->deltaTime;
     
-    // Keyboard panning
-    Vector3 moveDir = {0, 0, 0};
-    
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) moveDir.z -= 1.0f;
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) moveDir.z += 1.0f;
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) moveDir.x -= 1.0f;
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) moveDir.x += 1.0f;
-    
-    // Gamepad panning (left stick and D-pad)
-    if (engine->activeGamepad >= 0) {
-        Vector2 leftStick = engine->gamepadLeftStick[engine->activeGamepad];
-        
-        // Left stick
-        if (fabsf(leftStick.x) > 0.1f) moveDir.x += leftStick.x;
-        if (fabsf(leftStick.y) > 0.1f) moveDir.z += leftStick.y;
-        
-        // D-pad
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_LEFT)) moveDir.x -= 1.0f;
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_RIGHT)) moveDir.x += 1.0f;
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_UP)) moveDir.z -= 1.0f;
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN)) moveDir.z += 1.0f;
-    }
+    // Pan actions (keys, left stick and D-pad)
+    Vector3 moveDir = {
+        input->value[ACTION_PAN_RIGHT] - input->value[ACTION_PAN_LEFT],
+        0,
+        input->value[ACTION_PAN_DOWN] - input->value[ACTION_PAN_UP]
+    };
     
     // Edge scrolling
-    Vector2 mousePos = GetMousePosition();
+    Vector2 mousePos = input->mouseScreenPosition;
     if (mousePos.x < CAMERA_EDGE_SCROLL_ZONE) moveDir.x -= 1.0f;
     if (mousePos.x > engine->windowWidth - CAMERA_EDGE_SCROLL_ZONE) moveDir.x += 1.0f;
     if (mousePos.y < CAMERA_EDGE_SCROLL_ZONE) moveDir.z -= 1.0f;
@@ -189,81 +154,46 @@ void Camera_UpdateIsometric(EngineState* engine) {
     if (Vector3Length(moveDir) > 0) {
         moveDir = Vector3Normalize(moveDir);
         // Speed boost with shift key or gamepad left bumper
-        bool speedBoost = IsKeyDown(KEY_LEFT_SHIFT) || 
-                         (engine->activeGamepad >= 0 && IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_TRIGGER_1));
-        float speed = speedBoost ? CAMERA_PAN_SPEED * 2.0f : CAMERA_PAN_SPEED;
+        float speed = input->down[ACTION_PAN_FAST] ? CAMERA_PAN_SPEED * 2.0f : CAMERA_PAN_SPEED;
         cam->targetTarget = Vector3Add(cam->targetTarget, Vector3Scale(moveDir, speed * dt));
     }
     
-    // Gamepad pan with right stick (alternative control scheme)
-    if (engine->activeGamepad >= 0) {
-        Vector2 rightStick = engine->gamepadRightStick[engine->activeGamepad];
-        if (fabsf(rightStick.x) > 0.1f || fabsf(rightStick.y) > 0.1f) {
-            float panSpeed = cam->height * 0.5f * dt;
-            cam->targetTarget.x += rightStick.x * panSpeed;
-            cam->targetTarget.z += rightStick.y * panSpeed;
-        }
+    // Look actions pan as well (right stick, alternative control scheme)
+    Vector2 look = {
+        input->value[ACTION_LOOK_RIGHT] - input->value[ACTION_LOOK_LEFT],
+        input->value[ACTION_LOOK_DOWN] - input->value[ACTION_LOOK_UP]
+    };
+    if (look.x != 0 || look.y != 0) {
+        float panSpeed = cam->height * 0.5f * dt;
+        cam->targetTarget.x += look.x * panSpeed;
+        cam->targetTarget.z += look.y * panSpeed;
     }
     
     // Middle mouse pan
-    if (IsMouseButtonDown(MOUSE_MIDDLE_BUTTON)) {
-        Vector2 mouseDelta = GetMouseDelta();
+    if (input->down[ACTION_CAMERA_DRAG]) {
+        Vector2 mouseDelta = input->mouseDelta;
         cam->targetTarget.x -= mouseDelta.x * 0.02f * cam->height;
         cam->targetTarget.z -= mouseDelta.y * 0.02f * cam->height;
     }
     
     // Mouse zoom (adjust height)
-    float wheel = GetMouseWheelMove();
+    float wheel = input->mouseWheel;
     if (wheel != 0) {
         cam->height -= wheel * ISO_CAMERA_ZOOM_SPEED;
         if (cam->height < ISO_CAMERA_MIN_HEIGHT) cam->height = ISO_CAMERA_MIN_HEIGHT;
         if (cam->height > ISO_CAMERA_MAX_HEIGHT) cam->height = ISO_CAMERA_MAX_HEIGHT;
     }
     
-    // Gamepad zoom (left bumper and left trigger only, or stick buttons)
-    if (engine->activeGamepad >= 0) {
-        float zoomInput = 0;
-        
-        // Use left bumper for zoom in (decrease height)
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_TRIGGER_1)) zoomInput -= 1.0f;
-        
-        // Use left trigger for zoom out (increase height) - analog
-        float leftTrigger = engine->gamepadLeftTrigger[engine->activeGamepad];
-        if (leftTrigger > 0.1f) zoomInput += leftTrigger;
-        
-        // Alternative: Use stick buttons for zoom
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_THUMB)) zoomInput -= 1.0f;   // L3 zoom in
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_THUMB)) zoomInput += 1.0f;  // R3 zoom out
-        
-        if (zoomInput != 0) {
-            cam->height += zoomInput * ISO_CAMERA_ZOOM_SPEED * 10.0f * dt;
-            if (cam->height < ISO_CAMERA_MIN_HEIGHT) cam->height = ISO_CAMERA_MIN_HEIGHT;
-            if (cam->height > ISO_CAMERA_MAX_HEIGHT) cam->height = ISO_CAMERA_MAX_HEIGHT;
-        }
-    }
-    
-    // Selection box
-    if (engine->viewMode == VIEW_MODE_ISOMETRIC) {
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            cam->selecting = true;
-            cam->selectionStart = GetMousePosition();
-            cam->selectionEnd = cam->selectionStart;
-        }
-        
-        if (cam->selecting) {
-            cam->selectionEnd = GetMousePosition();
-            
-            if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
-                // Perform selection
-                Entity_SelectInBox(engine, cam->selectionStart, cam->selectionEnd);
-                cam->selecting = false;
-            }
-        }
+    // Zoom actions (zooming in lowers the camera)
+    float zoomInput = input->value[ACTION_ZOOM_OUT] - input->value[ACTION_ZOOM_IN];
+    if (zoomInput != 0) {
+        cam->height += zoomInput * ISO_CAMERA_ZOOM_SPEED * 10.0f * dt;
+        if (cam->height < ISO_CAMERA_MIN_HEIGHT) cam->height = ISO_CAMERA_MIN_HEIGHT;
+        if (cam->height > ISO_CAMERA_MAX_HEIGHT) cam->height = ISO_CAMERA_MAX_HEIGHT;
     }
     
     // Reset camera (R key or gamepad Select button)
-    if (IsKeyPressed(KEY_R) || 
-        (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_MIDDLE_LEFT))) {
+    if (input->pressed[ACTION_CAMERA_RESET]) {
         cam->targetTarget = (Vector3){0, 0, 0};
         cam->height = 15.0f;
     }
@@ -282,6 +212,41 @@ void Camera_UpdateIsometric(EngineState* engine) {
     // Apply to engine camera
     engine->camera.position = cam->position;
     engine->camera.target = cam->target;
+    
+    // Selection box, against this frame's camera and UI canvas
+    if (engine->viewMode == VIEW_MODE_ISOMETRIC) {
+        Camera_Apply(engine);
+        
+        if (input->pressed[ACTION_SELECT]) {
+            cam->selecting = true;
+            cam->selectionStart = input->mousePosition;
+            cam->selectionEnd = cam->selectionStart;
+        }
+        
+        if (cam->selecting) {
+            cam->selectionEnd = input->mousePosition;
+            
+            if (input->released[ACTION_SELECT]) {
+                // Perform selection; Shift adds to it, Ctrl removes from it
+                SelectMode mode = SELECT_REPLACE;
+                if (input->down[ACTION_SELECT_ADD]) {
+                    mode = SELECT_ADD;
+                } else if (input->down[ACTION_SELECT_REMOVE]) {
+                    mode = SELECT_REMOVE;
+                }
+                if (Vector2Distance(cam->selectionStart, cam->selectionEnd) < ISO_CAMERA_CLICK_SLOP) {
+                    // A click picks the entity under the cursor
+                    if (mode == SELECT_REPLACE) Entity_ClearSelection(engine);
+                    Entity_Select(engine, Entity_Pick(engine, cam->selectionEnd), mode != SELECT_REMOVE);
+                } else {
+                    Entity_SelectInBox(engine, cam->selectionStart, cam->selectionEnd, mode);
+                }
+                cam->selecting = false;
+            }
+        }
+    }
+    
+    PROFILE_END();
 }
 
 void Camera_SetMode(EngineState* engine, ViewMode mode) {
@@ -306,6 +271,27 @@ void Camera_SetMode(EngineState* engine, ViewMode mode) {
 void Camera_Apply(EngineState* engine) {
     if (!engine) return;
     
-    // Camera settings are already applied in the update functions
-    // This function can be used for additional camera effects or post-processing
+    // Same matrices BeginMode3D() builds, but for the UI canvas so projected
+    // points line up with the mouse and the HUD
+    const Camera3D* camera = &engine->camera;
+    CameraMatrices* matrices = &engine->cameraMatrices;
+    matrices->width = Engine_GetUIWidth(engine);
+    matrices->height = Engine_GetUIHeight(engine);
+    double aspect = (matrices->height > 0) ? (double)matrices->width / matrices->height : 1.0;
+    
+    matrices->view = MatrixLookAt(camera->position, camera->target, camera->up);
+    if (camera->projection == CAMERA_ORTHOGRAPHIC) {
+        double top = camera->fovy / 2.0;
+        double right = top * aspect;
+        matrices->projection = MatrixOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    } else {
+        matrices->projection = MatrixPerspective(camera->fovy * DEG2RAD, aspect,
+                                                 RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    }
+    matrices->viewProjection = MatrixMultiply(matrices->view, matrices->projection);
+    matrices->inverseViewProjection = MatrixInvert(matrices->viewProjection);
+    
+    matrices->forward = Vector3Normalize(Vector3Subtract(camera->target, camera->position));
+    matrices->right = Vector3Normalize(Vector3CrossProduct(matrices->forward, camera->up));
+    matrices->up = Vector3CrossProduct(matrices->right, matrices->forward);
 }
\ No newline at end of file
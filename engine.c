@@ -1,4 +1,5 @@
 #include "engine.h"
+#include <rlgl.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -44,10 +45,6 @@ void Utils_SelectInternalResolution(EngineState* engine, int monitorWidth, int m
 }
 
 EngineState* Engine_Init(int width, int height, const char* title) {
-    // Suppress unused parameter warnings (using fullscreen mode instead)
-    (void)width;
-    (void)height;
-    
     // Allocate engine state
     EngineState* engine = (EngineState*)calloc(1, sizeof(EngineState));
     if (!engine) {
@@ -58,33 +55,12 @@ EngineState* Engine_Init(int width, int height, const char* title) {
     // Detect monitor resolution
     engine->windowTitle = title ? title : ENGINE_NAME;
     
-    // Get monitor info before creating window
-    // Note: On some systems, we need to initialize video subsystem first
-    SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
-    
-    // Get primary monitor dimensions (monitor 0)
-    int monitorCount = GetMonitorCount();
-    int monitor = (monitorCount > 0) ? 0 : -1;
-    int monitorWidth = 1920;  // Default fallback
-    int monitorHeight = 1080; // Default fallback
-    
-    // Try to get actual monitor dimensions if available
-    if (monitor >= 0) {
-        // Create a temporary window to properly initialize the graphics context
-        InitWindow(100, 100, engine->windowTitle);
-        monitorWidth = GetMonitorWidth(monitor);
-        monitorHeight = GetMonitorHeight(monitor);
-        CloseWindow();
-    }
-    
-    // Now initialize with monitor resolution
-    engine->windowWidth = (width > 0) ? width : monitorWidth;
-    engine->windowHeight = (height > 0) ? height : monitorHeight;
-    
-    // Reinitialize window with proper size and go fullscreen
+    // Create the window once: with a 0x0 size raylib opens it fullscreen at
+    // the monitor's resolution, so there is no need for a probe window
     SetConfigFlags(FLAG_FULLSCREEN_MODE | FLAG_VSYNC_HINT);
-    InitWindow(engine->windowWidth, engine->windowHeight, engine->windowTitle);
-    SetTargetFPS(DEFAULT_FPS);
+    InitWindow(width > 0 ? width : 0, height > 0 ? height : 0, engine->windowTitle);
+    Engine_SetPacing(engine, PACING_VSYNC, DEFAULT_FPS, false);
+    Telemetry_MarkStartup("window + GL context");
     
     // Disable ESC key as exit key so we can handle it ourselves
     SetExitKey(KEY_NULL);
@@ -94,6 +70,14 @@ EngineState* Engine_Init(int width, int height, const char* title) {
         ToggleFullscreen();
     }
     
+    int monitor = GetCurrentMonitor();
+    int monitorWidth = GetMonitorWidth(monitor);
+    int monitorHeight = GetMonitorHeight(monitor);
+    if (monitorWidth <= 0 || monitorHeight <= 0) {
+        monitorWidth = 1920;  // Default fallback
+        monitorHeight = 1080;
+    }
+    
     // Store actual dimensions (may differ from requested)
     engine->windowWidth = GetScreenWidth();
     engine->windowHeight = GetScreenHeight();
@@ -105,16 +89,21 @@ EngineState* Engine_Init(int width, int height, const char* title) {
     // Select appropriate internal resolution based on monitor aspect ratio
     Utils_SelectInternalResolution(engine, monitorWidth, monitorHeight);
     
-    // Initialize low-resolution render texture with dynamic resolution
-    engine->renderTarget = LoadRenderTexture(engine->internalWidth, engine->internalHeight);
-    SetTextureFilter(engine->renderTarget.texture, TEXTURE_FILTER_POINT); // Pixelated look
-    SetTextureWrap(engine->renderTarget.texture, TEXTURE_WRAP_CLAMP);  // Prevent edge bleeding
+    // Frame timing and idle rendering start from window creation
+    engine->lastFrameTime = GetTime();
+    engine->lastActivityTime = engine->lastFrameTime;
+    engine->lastPresentTime = engine->lastFrameTime;
+    
+    // Initialize low-resolution 3D render texture with dynamic resolution
+    Engine_SetSceneScale(engine, 1.0f);
     engine->useInternalResolution = true;  // Enable internal resolution by default
     engine->maintainAspectRatio = false;  // Start with stretched full screen
     
-    // Set up source and destination rectangles for scaling with dynamic resolution
-    engine->sourceRect = (Rectangle){ 0, 0, (float)engine->internalWidth, (float)engine->internalHeight };
+    // Load CRT shader and the shaderless scanline texture
+    Render_InitPostProcess(engine);
+    Telemetry_MarkStartup("render target");
     
+    // Set up destination rectangle for scaling with dynamic resolution
     // Set destination rectangle to fill entire screen
     engine->destRect = (Rectangle){
         0,
@@ -138,12 +127,7 @@ EngineState* Engine_Init(int width, int height, const char* title) {
     engine->viewMode = VIEW_MODE_ISOMETRIC;
     
     // Initialize entities
-    engine->entityCount = 0;
-    engine->nextEntityId = 1;
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        engine->entities[i].active = false;
-        engine->entities[i].id = 0;
-    }
+    Entity_ResetAll(engine);
     
     // Initialize control groups
     for (int i = 0; i < MAX_CONTROL_GROUPS; i++) {
@@ -151,22 +135,22 @@ EngineState* Engine_Init(int width, int height, const char* title) {
         engine->controlGroups[i].entityCount = 0;
     }
     
-    // Initialize gamepad state
+    // Initialize gamepad state and the default controls
     engine->activeGamepad = -1;
     for (int i = 0; i < MAX_GAMEPADS; i++) {
         engine->gamepadConnected[i] = false;
-        engine->gamepadLeftStick[i] = (Vector2){0, 0};
-        engine->gamepadRightStick[i] = (Vector2){0, 0};
-        engine->gamepadLeftTrigger[i] = 0;
-        engine->gamepadRightTrigger[i] = 0;
     }
+    Input_ResetBindings();
     
     // Set default display options
     engine->showDebugInfo = true;
     engine->showUI = true;
     engine->showScanlines = false;  // Scanlines off by default
+    engine->showCurvature = false;
+    engine->showVignette = false;
     
     engine->running = true;
+    Telemetry_MarkStartup("engine state");
     
     return engine;
 }
@@ -174,10 +158,14 @@ EngineState* Engine_Init(int width, int height, const char* title) {
 void Engine_Shutdown(EngineState* engine) {
     if (!engine) return;
     
-    // Unload render texture
-    if (engine->useInternalResolution) {
-        UnloadRenderTexture(engine->renderTarget);
-    }
+    // Unload render texture and post-processing resources
+    UnloadRenderTexture(engine->renderTarget);
+    Render_UnloadPostProcess(engine);
+    Render_UnloadStats(engine);
+    if (engine->writeTelemetry) Telemetry_WriteSummary(engine);
+#ifdef PROFILER_ENABLED
+    Profiler_Shutdown();
+#endif
     
     // Clean up entities with custom data
     for (int i = 0; i < MAX_ENTITIES; i++) {
@@ -190,18 +178,130 @@ void Engine_Shutdown(EngineState* engine) {
     free(engine);
 }
 
-void Engine_BeginFrame(EngineState* engine) {
+// =====================================
+// Frame Pacing
+// =====================================
+
+static const char* pacingNames[PACING_MODE_COUNT] = { "vsync", "uncapped", "limiter" };
+
+const char* Engine_GetPacingName(PacingMode mode) {
+    if (mode < 0 || mode >= PACING_MODE_COUNT) return "unknown";
+    return pacingNames[mode];
+}
+
+void Engine_SetPacing(EngineState* engine, PacingMode mode, int targetFps, bool lateLatch) {
+    if (!engine || mode < 0 || mode >= PACING_MODE_COUNT) return;
+    if (targetFps <= 0) targetFps = DEFAULT_FPS;
+    
+    if (mode == PACING_VSYNC) {
+        // No raylib cap on top: it would wait after the swap at a rate other
+        // than the refresh the late-latch prediction assumes
+        SetWindowState(FLAG_VSYNC_HINT);
+        SetTargetFPS(0);
+        int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+        engine->pacingPeriodNs = 1000000000LL / (refreshRate > 0 ? refreshRate : targetFps);
+    } else {
+        ClearWindowState(FLAG_VSYNC_HINT);
+        SetTargetFPS(0);
+        engine->pacingPeriodNs = (mode == PACING_LIMITER) ? 1000000000LL / targetFps : 0;
+    }
+    
+    engine->pacingMode = mode;
+    engine->lateLatch = lateLatch && mode != PACING_UNCAPPED;
+    engine->pacingDeadlineNs = 0;
+    engine->pacingWorkNs = 0;
+    TraceLog(LOG_INFO, "Pacing: %s, %.2fms period%s", pacingNames[mode], engine->pacingPeriodNs / 1000000.0,
+             engine->lateLatch ? ", late latch" : "");
+}
+
+// Sleep most of the way, then spin: OS sleeps can overshoot by a scheduler tick
+static void Engine_WaitUntil(long long deadlineNs) {
+    long long remainingNs = deadlineNs - Utils_GetTimeNs();
+    if (remainingNs > PACING_SPIN_NS) {
+        WaitTime((remainingNs - PACING_SPIN_NS) / 1000000000.0);
+    }
+    while (Utils_GetTimeNs() < deadlineNs) {
+        // Spin
+    }
+}
+
+// Advance the limiter by one period; after a long stall, restart from now
+// instead of rushing through frames to catch up
+static long long Engine_NextDeadline(EngineState* engine) {
+    long long now = Utils_GetTimeNs();
+    engine->pacingDeadlineNs += engine->pacingPeriodNs;
+    if (engine->pacingDeadlineNs < now - engine->pacingPeriodNs) {
+        engine->pacingDeadlineNs = now;
+    }
+    return engine->pacingDeadlineNs;
+}
+
+void Engine_LatchFrame(EngineState* engine) {
     if (!engine) return;
     
-    // Update timing
-    engine->deltaTime = GetFrameTime();
+    if (engine->lateLatch && !engine->idle) {
+        PROFILE_BEGIN("LateLatch");
+        if (engine->pacingMode == PACING_LIMITER) {
+            // The limiter waits before input instead of before the swap
+            Engine_WaitUntil(Engine_NextDeadline(engine));
+        } else if (engine->lastSwapNs > 0) {
+            // The next vblank is a refresh period after the last swap returned;
+            // start just early enough for the predicted frame to make it
+            Engine_WaitUntil(engine->lastSwapNs + engine->pacingPeriodNs -
+                             engine->pacingWorkNs - PACING_LATCH_MARGIN_NS);
+        }
+        PROFILE_END();
+    }
+    engine->latchNs = Utils_GetTimeNs();
+}
+
+// True when anything happened this frame that could change what is on screen
+static bool Engine_HasActivity(EngineState* engine) {
+    return IsWindowResized() || engine->input.activity;
+}
+
+bool Engine_BeginFrame(EngineState* engine) {
+    if (!engine) return false;
+    PROFILE_BEGIN("Engine_BeginFrame");
+    
+    // Update timing from the wall clock so skipped idle frames are accounted for.
+    // Clamp so a long stall doesn't turn into one huge simulation step.
+    double now = GetTime();
+    engine->deltaTime = (float)fmin(now - engine->lastFrameTime, 0.25);
+    engine->lastFrameTime = now;
     engine->totalTime += engine->deltaTime;
+    PROFILE_COUNTER("delta_ms", engine->deltaTime * 1000.0);
+    const InputFrame* input = &engine->input;
     
-    // Update input state
-    Input_Update(engine);
+    // On-demand rendering: while idle, only draw when something changed,
+    // shortly after input (camera smoothing), or on a slow periodic refresh
+    if (Engine_HasActivity(engine)) {
+        engine->lastActivityTime = now;
+    }
+    if (engine->idle &&
+        now - engine->lastActivityTime > IDLE_LINGER_TIME &&
+        now - engine->lastPresentTime < IDLE_REFRESH_INTERVAL) {
+        // EndDrawing() normally polls input; do it here and sleep instead
+        engine->idleSkippedFrames++;
+        engine->frameStartNs = 0;
+        PollInputEvents();
+        WaitTime(IDLE_POLL_INTERVAL);
+        PROFILE_END();
+        return false;
+    }
+    engine->lastPresentTime = now;
+    
+    // Frame-to-frame time, only while playing; menus redraw on demand
+    long long frameStartNs = Utils_GetTimeNs();
+    if (engine->frameStartNs > 0 && !engine->idle) {
+        Telemetry_Record(TELEMETRY_FRAME, frameStartNs - engine->frameStartNs);
+    } else {
+        engine->lastSwapIntervalNs = 0;
+    }
+    engine->frameStartNs = frameStartNs;
     
     // Toggle fullscreen with Alt+Enter or just F11
-    if ((IsKeyDown(KEY_LEFT_ALT) && IsKeyPressed(KEY_ENTER)) || IsKeyPressed(KEY_F11)) {
+    if (input->pressed[ACTION_TOGGLE_FULLSCREEN]) {
         ToggleFullscreen();
         
         // Wait a frame for the window to resize
@@ -245,8 +345,9 @@ void Engine_BeginFrame(EngineState* engine) {
     }
     
     // Toggle internal resolution with F1
-    if (IsKeyPressed(KEY_F1)) {
+    if (input->pressed[ACTION_TOGGLE_INTERNAL_RESOLUTION]) {
         engine->useInternalResolution = !engine->useInternalResolution;
+        engine->isoCamera.selecting = false;  // The box was started on the other canvas
         
         // Update destination rectangle for new window size in case it changed
         if (engine->useInternalResolution) {
@@ -281,12 +382,48 @@ void Engine_BeginFrame(EngineState* engine) {
     }
     
     // Toggle scanline effect with F2
-    if (IsKeyPressed(KEY_F2)) {
+    if (input->pressed[ACTION_TOGGLE_SCANLINES]) {
         engine->showScanlines = !engine->showScanlines;
     }
     
+    // Toggle CRT curvature with F4 and vignette with F5
+    if (input->pressed[ACTION_TOGGLE_CURVATURE]) {
+        engine->showCurvature = !engine->showCurvature;
+    }
+    if (input->pressed[ACTION_TOGGLE_VIGNETTE]) {
+        engine->showVignette = !engine->showVignette;
+    }
+    
+    // Cycle 3D scene resolution with F6 (100% -> 75% -> 50%)
+    if (input->pressed[ACTION_CYCLE_SCENE_SCALE]) {
+        float scale = engine->sceneScale - SCENE_SCALE_STEP;
+        Engine_SetSceneScale(engine, (scale < SCENE_SCALE_MIN - 0.01f) ? 1.0f : scale);
+    }
+    
+    // Toggle render stats CSV recording with F7
+    if (input->pressed[ACTION_TOGGLE_STATS_RECORDING]) {
+        Render_StatsToggleRecording(engine);
+    }
+    
+    // Toggle the input-to-present latency probe with F9
+    if (input->pressed[ACTION_TOGGLE_LATENCY_PROBE]) {
+        engine->measureLatency = !engine->measureLatency;
+        memset(engine->latencyMarks, 0, sizeof(engine->latencyMarks));
+    }
+    
+#ifdef PROFILER_ENABLED
+    // Start or stop a Chrome trace capture with F8
+    if (input->pressed[ACTION_TOGGLE_TRACE_CAPTURE]) {
+        if (Profiler_IsCapturing()) {
+            Profiler_StopCapture();
+        } else {
+            Profiler_StartCapture(PROFILER_CAPTURE_FRAMES);
+        }
+    }
+#endif
+    
     // Toggle aspect ratio mode with F3
-    if (IsKeyPressed(KEY_F3)) {
+    if (input->pressed[ACTION_TOGGLE_ASPECT_RATIO]) {
         engine->maintainAspectRatio = !engine->maintainAspectRatio;
         
         // Recalculate destination rectangle based on aspect ratio mode
@@ -328,10 +465,21 @@ void Engine_BeginFrame(EngineState* engine) {
     // Apply camera settings
     Camera_Apply(engine);
     
+    // Entity under the cursor, outlined by Entity_RenderAll()
+    engine->hoveredEntityId = 0;
+    if (engine->viewMode == VIEW_MODE_ISOMETRIC) {
+        Entity* hovered = Entity_Pick(engine, engine->input.mousePosition);
+        if (hovered) engine->hoveredEntityId = hovered->id;
+    }
+    
+    // Start counting draw submissions for this frame
+    Render_StatsBeginFrame(engine);
+    
     // Begin drawing
     if (engine->useInternalResolution) {
         // Begin drawing to render texture
         BeginTextureMode(engine->renderTarget);
+        Render_StatsTargetSwitch(engine);
         ClearBackground((Color){32, 32, 32, 255});
         BeginMode3D(engine->camera);
     } else {
@@ -340,6 +488,9 @@ void Engine_BeginFrame(EngineState* engine) {
         ClearBackground((Color){32, 32, 32, 255});
         BeginMode3D(engine->camera);
     }
+    
+    PROFILE_END();
+    return true;
 }
 
 void Engine_End3D(EngineState* engine) {
@@ -347,49 +498,146 @@ void Engine_End3D(EngineState* engine) {
     
     // End 3D mode
     EndMode3D();
+    
+    // Timestamp input that arrived while the scene was built
+    Input_Sample(engine);
+    
+    if (engine->useInternalResolution) {
+        // Finish the 3D pass and composite it under the UI layer
+        EndTextureMode();
+        Render_StatsTargetSwitch(engine);
+        
+        BeginDrawing();
+        ClearBackground(BLACK);  // Black letterboxing
+        Render_PresentTarget(engine);
+        
+        // UI is drawn straight to the backbuffer, after the post-processing,
+        // but laid out on the internal resolution canvas and scaled onto the
+        // same area as the 3D image. Text glyphs are magnified with it.
+        rlPushMatrix();
+        rlTranslatef(engine->destRect.x, engine->destRect.y, 0.0f);
+        rlScalef(engine->destRect.width / engine->internalWidth,
+                 engine->destRect.height / engine->internalHeight, 1.0f);
+    }
+    
+    // Start timing the 2D UI pass
+    engine->uiStartTime = GetTime();
+    Text_BeginFrame();
 }
 
 void Engine_EndFrame(EngineState* engine) {
     if (!engine) return;
+    PROFILE_BEGIN("Engine_EndFrame");
     
-    // Render 2D UI elements (to render texture if using internal resolution)
+    // Render 2D UI elements (on the UI canvas set up by Engine_End3D)
     if (engine->isoCamera.selecting) {
         Render_SelectionBox(engine->isoCamera.selectionStart, engine->isoCamera.selectionEnd);
     }
     
     if (engine->showDebugInfo) {
+        Render_StatsBeginZone(engine, "overlay");
         Render_DebugInfo(engine);
+        Render_StatsEndZone(engine);
     }
     
+    // Shown by the debug overlay on the next frame
+    engine->uiCpuTime = (float)(GetTime() - engine->uiStartTime);
+    
     if (engine->useInternalResolution) {
-        // End render texture mode
-        EndTextureMode();
-        
-        // Now draw the render texture to the actual screen
-        BeginDrawing();
-        ClearBackground(BLACK);  // Black letterboxing
-        
-        // Draw the render texture scaled up (flip Y coordinate for correct orientation)
-        Rectangle flippedSource = { 0, 0, (float)engine->internalWidth, -(float)engine->internalHeight };
-        DrawTexturePro(engine->renderTarget.texture,
-                      flippedSource,
-                      engine->destRect,
-                      (Vector2){0, 0},
-                      0.0f,
-                      WHITE);
-        
-        // Optional: Add scanline effect for retro CRT look
-        if (engine->useInternalResolution && engine->showScanlines) {
-            for (int y = 0; y < engine->windowHeight; y += 2) {
-                DrawRectangle(0, y, engine->windowWidth, 1, (Color){0, 0, 0, 30});
-            }
+        // Drop the UI canvas transform
+        rlPopMatrix();
+    }
+    
+    Render_StatsEndFrame(engine);
+    if (!engine->idle) {
+        Telemetry_Record(TELEMETRY_RENDER, Utils_GetTimeNs() - engine->frameStartNs);
+    }
+    PROFILE_END();
+    
+    // Late latch learns how long a frame takes from the latch to here
+    if (engine->latchNs > 0) {
+        long long workNs = Utils_GetTimeNs() - engine->latchNs;
+        long long decayedNs = engine->pacingWorkNs - engine->pacingWorkNs / 32;
+        engine->pacingWorkNs = (workNs > decayedNs) ? workNs : decayedNs;
+    }
+    
+    // Without late latch the limiter waits here, so frames reach the screen evenly spaced
+    if (engine->pacingMode == PACING_LIMITER && !engine->lateLatch) {
+        PROFILE_BEGIN("Limiter");
+        Engine_WaitUntil(Engine_NextDeadline(engine));
+        PROFILE_END();
+    }
+    
+    // Sample again right before the swap, so changes seen by EndDrawing()'s
+    // poll are stamped within the swap and limiter wait rather than the whole frame
+    Input_Sample(engine);
+    
+    // Buffer swap and frame limiter wait, kept apart from the CPU work above
+    PROFILE_BEGIN("EndDrawing");
+    EndDrawing();
+    PROFILE_END();
+    Telemetry_MarkLatency(engine, LATENCY_PRESENT);
+    
+    // Swap-to-swap jitter, only between consecutive drawn frames
+    long long swapNs = Utils_GetTimeNs();
+    if (engine->lastSwapNs > 0 && !engine->idle) {
+        long long intervalNs = swapNs - engine->lastSwapNs;
+        if (engine->lastSwapIntervalNs > 0) {
+            long long jitterNs = intervalNs - engine->lastSwapIntervalNs;
+            Telemetry_Record(TELEMETRY_PRESENT_JITTER, (jitterNs < 0) ? -jitterNs : jitterNs);
         }
-        
-        EndDrawing();
-    } else {
-        // Normal ending
-        EndDrawing();
+        engine->lastSwapIntervalNs = intervalNs;
     }
+    engine->lastSwapNs = swapNs;
+}
+
+void Engine_SetIdle(EngineState* engine, bool idle) {
+    if (!engine) return;
+    
+    if (idle && !engine->idle) {
+        // Entering idle: keep drawing through the linger window first
+        engine->lastActivityTime = GetTime();
+        engine->idleSkippedFrames = 0;
+    }
+    engine->idle = idle;
+}
+
+// Resize the 3D render target; the UI canvas keeps the internal resolution
+void Engine_SetSceneScale(EngineState* engine, float scale) {
+    if (!engine) return;
+    
+    if (scale < SCENE_SCALE_MIN) scale = SCENE_SCALE_MIN;
+    if (scale > 1.0f) scale = 1.0f;
+    
+    int width = (int)(engine->internalWidth * scale);
+    int height = (int)(engine->internalHeight * scale);
+    
+    if (engine->renderTarget.id != 0) {
+        if (engine->renderTarget.texture.width == width &&
+            engine->renderTarget.texture.height == height) {
+            engine->sceneScale = scale;
+            return;
+        }
+        UnloadRenderTexture(engine->renderTarget);
+    }
+    
+    engine->renderTarget = LoadRenderTexture(width, height);
+    SetTextureFilter(engine->renderTarget.texture, TEXTURE_FILTER_POINT); // Pixelated look
+    SetTextureWrap(engine->renderTarget.texture, TEXTURE_WRAP_CLAMP);  // Prevent edge bleeding
+    engine->sourceRect = (Rectangle){ 0, 0, (float)width, (float)height };
+    engine->sceneScale = scale;
+    
+    TraceLog(LOG_INFO, "3D scene resolution: %dx%d (%d%%)", width, height, (int)(scale * 100.0f + 0.5f));
+}
+
+int Engine_GetUIWidth(EngineState* engine) {
+    if (!engine) return 0;
+    return engine->useInternalResolution ? engine->internalWidth : engine->windowWidth;
+}
+
+int Engine_GetUIHeight(EngineState* engine) {
+    if (!engine) return 0;
+    return engine->useInternalResolution ? engine->internalHeight : engine->windowHeight;
 }
 
 bool Engine_ShouldClose(EngineState* engine) {
@@ -400,28 +648,139 @@ bool Engine_ShouldClose(EngineState* engine) {
 // Entity Management
 // =====================================
 
+// Grid cell holding a position, clamped to the grid
+static int Entity_GridCell(Vector3 position) {
+    int x = (int)floorf(position.x / ENTITY_GRID_CELL_SIZE) + ENTITY_GRID_DIM / 2;
+    int z = (int)floorf(position.z / ENTITY_GRID_CELL_SIZE) + ENTITY_GRID_DIM / 2;
+    if (x < 0) x = 0;
+    if (x > ENTITY_GRID_DIM - 1) x = ENTITY_GRID_DIM - 1;
+    if (z < 0) z = 0;
+    if (z > ENTITY_GRID_DIM - 1) z = ENTITY_GRID_DIM - 1;
+    return z * ENTITY_GRID_DIM + x;
+}
+
+static void Entity_GridInsert(EngineState* engine, int slot) {
+    Entity* entity = &engine->entities[slot];
+    int cell = Entity_GridCell(entity->position);
+    int head = engine->gridHeads[cell];
+    
+    entity->gridCell = cell;
+    entity->gridPrev = -1;
+    entity->gridNext = head;
+    if (head >= 0) engine->entities[head].gridPrev = slot;
+    engine->gridHeads[cell] = slot;
+    
+    if (entity->position.y < engine->gridMinY) engine->gridMinY = entity->position.y;
+    if (entity->position.y > engine->gridMaxY) engine->gridMaxY = entity->position.y;
+}
+
+static void Entity_GridRemove(EngineState* engine, int slot) {
+    Entity* entity = &engine->entities[slot];
+    if (entity->gridPrev >= 0) {
+        engine->entities[entity->gridPrev].gridNext = entity->gridNext;
+    } else {
+        engine->gridHeads[entity->gridCell] = entity->gridNext;
+    }
+    if (entity->gridNext >= 0) {
+        engine->entities[entity->gridNext].gridPrev = entity->gridPrev;
+    }
+    entity->gridPrev = -1;
+    entity->gridNext = -1;
+}
+
+void Entity_ResetAll(EngineState* engine) {
+    if (!engine) return;
+    
+    for (int i = 0; i < MAX_ENTITIES; i++) {
+        engine->entities[i].active = false;
+        engine->entities[i].id = 0;
+    }
+    for (int i = 0; i < ENTITY_GRID_CELLS; i++) {
+        engine->gridHeads[i] = -1;
+    }
+    engine->gridMinY = 0.0f;
+    engine->gridMaxY = 0.0f;
+    engine->entityCount = 0;
+    engine->selectedCount = 0;
+    engine->entityFreeHint = 0;
+}
+
+void Entity_SetPosition(EngineState* engine, Entity* entity, Vector3 position) {
+    if (!engine || !entity || !entity->active) return;
+    
+    entity->position = position;
+    
+    // Relink only when the entity crosses into another cell or leaves the height range
+    int slot = (int)(entity - engine->entities);
+    if (Entity_GridCell(position) != entity->gridCell ||
+        position.y < engine->gridMinY || position.y > engine->gridMaxY) {
+        Entity_GridRemove(engine, slot);
+        Entity_GridInsert(engine, slot);
+    }
+}
+
+// Entity_Pick() only looks one cell around an entity's own, so clamp each scale
+// axis to keep the bounds within ENTITY_PICK_MAX_EXTENT of the position
+static void Entity_ClampExtent(Entity* entity) {
+    const float* low = &entity->localBounds.min.x;
+    const float* high = &entity->localBounds.max.x;
+    float* scale = &entity->scale.x;
+    
+    for (int axis = 0; axis < 3; axis++) {
+        float reach = fmaxf(fabsf(low[axis]), fabsf(high[axis]));
+        if (reach * fabsf(scale[axis]) > ENTITY_PICK_MAX_EXTENT) {
+            TraceLog(LOG_WARNING, "Entity %d: scale %.2f on axis %d exceeds the pick extent, clamped",
+                     entity->id, scale[axis], axis);
+            scale[axis] = copysignf(ENTITY_PICK_MAX_EXTENT / reach, scale[axis]);
+        }
+    }
+}
+
+void Entity_SetScale(Entity* entity, Vector3 scale) {
+    if (!entity || !entity->active) return;
+    
+    entity->scale = scale;
+    Entity_ClampExtent(entity);
+}
+
+void Entity_SetModel(Entity* entity, Model* model) {
+    if (!entity || !entity->active) return;
+    
+    // Model bounds walk every vertex, so they are computed once here rather than per pick
+    entity->model = model;
+    entity->localBounds = model ? GetModelBoundingBox(*model)
+                                : (BoundingBox){ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
+    Entity_ClampExtent(entity);
+}
+
 Entity* Entity_Create(EngineState* engine, EntityType type) {
     if (!engine || engine->entityCount >= MAX_ENTITIES) {
         return NULL;
     }
     
     // Find first inactive entity slot
-    for (int i = 0; i < MAX_ENTITIES; i++) {
+    for (int i = engine->entityFreeHint; i < MAX_ENTITIES; i++) {
         if (!engine->entities[i].active) {
             Entity* entity = &engine->entities[i];
+            int generation = entity->generation % ENTITY_ID_MAX_GENERATION + 1;
             
             // Initialize entity
             memset(entity, 0, sizeof(Entity));
-            entity->id = engine->nextEntityId++;
+            entity->generation = generation;
+            entity->id = (generation << ENTITY_ID_SLOT_BITS) | i;
             entity->type = type;
             entity->active = true;
             entity->scale = (Vector3){1.0f, 1.0f, 1.0f};
+            entity->localBounds = (BoundingBox){ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
             entity->color = WHITE;
             entity->health = 100.0f;
             entity->maxHealth = 100.0f;
             entity->mass = 1.0f;
+            entity->selectedIndex = -1;
+            Entity_GridInsert(engine, i);
             
             engine->entityCount++;
+            engine->entityFreeHint = i + 1;
             return entity;
         }
     }
@@ -437,22 +796,24 @@ void Entity_Destroy(EngineState* engine, int entityId) {
         if (entity->customData) {
             free(entity->customData);
         }
+        int slot = (int)(entity - engine->entities);
+        Entity_Select(engine, entity, false);
+        Entity_GridRemove(engine, slot);
         entity->active = false;
         entity->id = 0;
         engine->entityCount--;
+        if (slot < engine->entityFreeHint) engine->entityFreeHint = slot;
     }
 }
 
 Entity* Entity_GetById(EngineState* engine, int entityId) {
     if (!engine || entityId <= 0) return NULL;
     
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (engine->entities[i].active && engine->entities[i].id == entityId) {
-            return &engine->entities[i];
-        }
-    }
+    int slot = entityId & ENTITY_ID_SLOT_MASK;
+    if (slot >= MAX_ENTITIES) return NULL;
     
-    return NULL;
+    Entity* entity = &engine->entities[slot];
+    return (entity->active && entity->id == entityId) ? entity : NULL;
 }
 
 void Entity_Update(EngineState* engine, Entity* entity) {
@@ -462,12 +823,22 @@ void Entity_Update(EngineState* engine, Entity* entity) {
     
     // Basic physics integration
     entity->velocity = Vector3Add(entity->velocity, Vector3Scale(entity->acceleration, dt));
-    entity->position = Vector3Add(entity->position, Vector3Scale(entity->velocity, dt));
+    Entity_SetPosition(engine, entity, Vector3Add(entity->position, Vector3Scale(entity->velocity, dt)));
     
     // Apply damping
     entity->velocity = Vector3Scale(entity->velocity, 0.98f);
 }
 
+// World-space bounds an entity is drawn with
+static BoundingBox Entity_GetBounds(const Entity* entity) {
+    Vector3 a = Vector3Multiply(entity->localBounds.min, entity->scale);
+    Vector3 b = Vector3Multiply(entity->localBounds.max, entity->scale);
+    
+    // A negative scale axis mirrors the box
+    return (BoundingBox){ Vector3Add(entity->position, Vector3Min(a, b)),
+                          Vector3Add(entity->position, Vector3Max(a, b)) };
+}
+
 void Entity_Render(Entity* entity) {
     if (!entity || !entity->active) return;
     
@@ -484,61 +855,303 @@ void Entity_Render(Entity* entity) {
         }
     } else {
         // Draw the model if available
-        DrawModel(*entity->model, entity->position, entity->scale.x, entity->color);
+        DrawModelEx(*entity->model, entity->position, (Vector3){ 0.0f, 1.0f, 0.0f }, 0.0f, entity->scale, entity->color);
     }
 }
 
-void Entity_Select(Entity* entity, bool selected) {
-    if (entity) {
-        entity->selected = selected;
+void Entity_RenderAll(EngineState* engine) {
+    if (!engine) return;
+    
+    // Stop scanning once every active entity has been drawn
+    int remaining = engine->entityCount;
+    for (int i = 0; i < MAX_ENTITIES && remaining > 0; i++) {
+        if (engine->entities[i].active) {
+            Entity* entity = &engine->entities[i];
+            Entity_Render(entity);
+            if (entity->id == engine->hoveredEntityId) {
+                DrawBoundingBox(Entity_GetBounds(entity), YELLOW);
+            }
+            remaining--;
+        }
+    }
+}
+
+// The selection is a dense array of entity slots; each selected entity keeps
+// its index in it, so selecting, deselecting, clearing and counting never
+// scan the entity table
+void Entity_Select(EngineState* engine, Entity* entity, bool selected) {
+    if (!engine || !entity || !entity->active || entity->selected == selected) return;
+    
+    if (selected) {
+        entity->selectedIndex = engine->selectedCount;
+        engine->selection[engine->selectedCount++] = (int)(entity - engine->entities);
+    } else {
+        // Move the last selected entity into the freed position
+        int last = engine->selection[--engine->selectedCount];
+        engine->selection[entity->selectedIndex] = last;
+        engine->entities[last].selectedIndex = entity->selectedIndex;
+        entity->selectedIndex = -1;
     }
+    entity->selected = selected;
 }
 
 void Entity_ClearSelection(EngineState* engine) {
     if (!engine) return;
     
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (engine->entities[i].active) {
-            engine->entities[i].selected = false;
-        }
+    for (int i = 0; i < engine->selectedCount; i++) {
+        Entity* entity = &engine->entities[engine->selection[i]];
+        entity->selected = false;
+        entity->selectedIndex = -1;
     }
+    engine->selectedCount = 0;
 }
 
 int Entity_GetSelectedCount(EngineState* engine) {
-    if (!engine) return 0;
+    return engine ? engine->selectedCount : 0;
+}
+
+// =====================================
+// Box Selection
+// =====================================
+
+// Half-space dot(normal, p) >= distance
+typedef struct {
+    Vector3 normal;
+    float distance;
+} SelectionPlane;
+
+// Canvas point at an NDC depth (-1 near, 1 far) back into world space
+static Vector3 Entity_Unproject(const CameraMatrices* matrices, Vector2 canvas, float depth) {
+    if (matrices->width <= 0 || matrices->height <= 0) return (Vector3){ 0, 0, 0 };
     
-    int count = 0;
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (engine->entities[i].active && engine->entities[i].selected) {
-            count++;
-        }
+    const Matrix* m = &matrices->inverseViewProjection;
+    float x = 2.0f * canvas.x / matrices->width - 1.0f;
+    float y = 1.0f - 2.0f * canvas.y / matrices->height;
+    float w = m->m3 * x + m->m7 * y + m->m11 * depth + m->m15;
+    if (w == 0.0f) return (Vector3){ 0, 0, 0 };
+    return (Vector3){
+        (m->m0 * x + m->m4 * y + m->m8 * depth + m->m12) / w,
+        (m->m1 * x + m->m5 * y + m->m9 * depth + m->m13) / w,
+        (m->m2 * x + m->m6 * y + m->m10 * depth + m->m14) / w
+    };
+}
+
+static bool Entity_InsidePlanes(const SelectionPlane* planes, int count, Vector3 p) {
+    for (int i = 0; i < count; i++) {
+        if (Vector3DotProduct(planes[i].normal, p) < planes[i].distance) return false;
     }
-    return count;
+    return true;
 }
 
-// Entity selection in screen space
-void Entity_SelectInBox(EngineState* engine, Vector2 start, Vector2 end) {
+// Grow [lo, hi] on XZ by the part of segment a-b inside the slab minY <= y <= maxY
+static void Entity_ClipToSlab(Vector3 a, Vector3 b, float minY, float maxY, Vector2* lo, Vector2* hi) {
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    float dy = b.y - a.y;
+    if (fabsf(dy) < 1e-6f) {
+        if (a.y < minY || a.y > maxY) return;
+    } else {
+        float ta = (minY - a.y) / dy;
+        float tb = (maxY - a.y) / dy;
+        t0 = fmaxf(t0, fminf(ta, tb));
+        t1 = fminf(t1, fmaxf(ta, tb));
+        if (t0 > t1) return;
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        Vector3 p = Vector3Lerp(a, b, i ? t1 : t0);
+        lo->x = fminf(lo->x, p.x);
+        lo->y = fminf(lo->y, p.z);
+        hi->x = fmaxf(hi->x, p.x);
+        hi->y = fmaxf(hi->y, p.z);
+    }
+}
+
+// Selects by entity position, like the old per-entity screen test, but as a
+// query: the drag rectangle becomes a sub-frustum of the camera (four side
+// planes plus the near plane), and only grid cells under its footprint are
+// visited. Cells entirely inside it are taken without testing each entity.
+void Entity_SelectInBox(EngineState* engine, Vector2 start, Vector2 end, SelectMode mode) {
     if (!engine) return;
     
-    // Clear previous selection
-    Entity_ClearSelection(engine);
+    if (mode == SELECT_REPLACE) {
+        Entity_ClearSelection(engine);
+    }
+    bool select = (mode != SELECT_REMOVE);
+    
+    // Matrices are only published once Camera_Apply() has run
+    if (engine->cameraMatrices.width <= 0) Camera_Apply(engine);
+    const CameraMatrices* matrices = &engine->cameraMatrices;
+    if (matrices->width <= 0 || matrices->height <= 0) return;
     
-    // Normalize box coordinates
+    // Box corners in order around the rectangle, at the near and far planes
     float minX = fminf(start.x, end.x);
     float maxX = fmaxf(start.x, end.x);
     float minY = fminf(start.y, end.y);
     float maxY = fmaxf(start.y, end.y);
+    if (maxX <= minX || maxY <= minY) return;  // A click, not a box
+    Vector2 corners[4] = { { minX, minY }, { maxX, minY }, { maxX, maxY }, { minX, maxY } };
+    Vector3 nearPoints[4];
+    Vector3 farPoints[4];
+    Vector3 center = { 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        nearPoints[i] = Entity_Unproject(matrices, corners[i], -1.0f);
+        farPoints[i] = Entity_Unproject(matrices, corners[i], 1.0f);
+        center = Vector3Add(center, Vector3Add(nearPoints[i], farPoints[i]));
+    }
+    center = Vector3Scale(center, 1.0f / 8.0f);
     
-    // Select entities within box
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (!engine->entities[i].active) continue;
+    // Side planes through each pair of neighbouring corner rays, facing the center
+    SelectionPlane planes[5];
+    int planeCount = 0;
+    for (int i = 0; i < 4; i++) {
+        int next = (i + 1) % 4;
+        Vector3 normal = Vector3CrossProduct(Vector3Subtract(farPoints[i], nearPoints[i]),
+                                             Vector3Subtract(nearPoints[next], nearPoints[i]));
+        float distance = Vector3DotProduct(normal, nearPoints[i]);
+        if (Vector3DotProduct(normal, center) < distance) {
+            normal = Vector3Negate(normal);
+            distance = -distance;
+        }
+        planes[planeCount++] = (SelectionPlane){ normal, distance };
+    }
+    planes[planeCount++] = (SelectionPlane){ matrices->forward, Vector3DotProduct(matrices->forward, nearPoints[0]) };
+    
+    // XZ footprint of the frustum within the height range entities occupy:
+    // its twelve edges clipped to that slab
+    Vector2 lo = { INFINITY, INFINITY };
+    Vector2 hi = { -INFINITY, -INFINITY };
+    for (int i = 0; i < 4; i++) {
+        int next = (i + 1) % 4;
+        Entity_ClipToSlab(nearPoints[i], farPoints[i], engine->gridMinY, engine->gridMaxY, &lo, &hi);
+        Entity_ClipToSlab(nearPoints[i], nearPoints[next], engine->gridMinY, engine->gridMaxY, &lo, &hi);
+        Entity_ClipToSlab(farPoints[i], farPoints[next], engine->gridMinY, engine->gridMaxY, &lo, &hi);
+    }
+    if (lo.x > hi.x || lo.y > hi.y) return;
+    
+    int loCell = Entity_GridCell((Vector3){ lo.x, 0, lo.y });
+    int hiCell = Entity_GridCell((Vector3){ hi.x, 0, hi.y });
+    int cellX0 = loCell % ENTITY_GRID_DIM, cellZ0 = loCell / ENTITY_GRID_DIM;
+    int cellX1 = hiCell % ENTITY_GRID_DIM, cellZ1 = hiCell / ENTITY_GRID_DIM;
+    
+    for (int cz = cellZ0; cz <= cellZ1; cz++) {
+        for (int cx = cellX0; cx <= cellX1; cx++) {
+            int slot = engine->gridHeads[cz * ENTITY_GRID_DIM + cx];
+            if (slot < 0) continue;
+            
+            // Edge cells also hold everything beyond the grid, so always test them per entity
+            bool edge = (cx == 0 || cz == 0 || cx == ENTITY_GRID_DIM - 1 || cz == ENTITY_GRID_DIM - 1);
+            bool partial = edge;
+            if (!edge) {
+                Vector3 boxMin = {
+                    (cx - ENTITY_GRID_DIM / 2) * ENTITY_GRID_CELL_SIZE, engine->gridMinY,
+                    (cz - ENTITY_GRID_DIM / 2) * ENTITY_GRID_CELL_SIZE
+                };
+                Vector3 boxMax = { boxMin.x + ENTITY_GRID_CELL_SIZE, engine->gridMaxY, boxMin.z + ENTITY_GRID_CELL_SIZE };
+                
+                // Nearest and farthest box corners along each plane normal
+                bool outside = false;
+                for (int p = 0; p < planeCount && !outside; p++) {
+                    Vector3 n = planes[p].normal;
+                    Vector3 most = { n.x >= 0 ? boxMax.x : boxMin.x, n.y >= 0 ? boxMax.y : boxMin.y, n.z >= 0 ? boxMax.z : boxMin.z };
+                    Vector3 least = { n.x >= 0 ? boxMin.x : boxMax.x, n.y >= 0 ? boxMin.y : boxMax.y, n.z >= 0 ? boxMin.z : boxMax.z };
+                    if (Vector3DotProduct(n, most) < planes[p].distance) outside = true;
+                    else if (Vector3DotProduct(n, least) < planes[p].distance) partial = true;
+                }
+                if (outside) continue;
+            }
+            
+            for (; slot >= 0; slot = engine->entities[slot].gridNext) {
+                Entity* entity = &engine->entities[slot];
+                if (partial && !Entity_InsidePlanes(planes, planeCount, entity->position)) continue;
+                Entity_Select(engine, entity, select);
+            }
+        }
+    }
+}
+
+// =====================================
+// Picking
+// =====================================
+
+// Walks the grid cells under the ray's XZ path, front to back. An entity can
+// reach ENTITY_PICK_MAX_EXTENT past its cell, so each step tests the cell's
+// neighbours too; after a step every hit closer than the step's exit has been
+// seen, and the walk stops as soon as the best hit is that close.
+Entity* Entity_Pick(EngineState* engine, Vector2 screenPos) {
+    if (!engine || engine->entityCount == 0) return NULL;
+    
+    if (engine->cameraMatrices.width <= 0) Camera_Apply(engine);
+    const CameraMatrices* matrices = &engine->cameraMatrices;
+    if (matrices->width <= 0 || matrices->height <= 0) return NULL;
+    
+    Vector3 nearPoint = Entity_Unproject(matrices, screenPos, -1.0f);
+    Vector3 farPoint = Entity_Unproject(matrices, screenPos, 1.0f);
+    Ray ray = { nearPoint, Vector3Normalize(Vector3Subtract(farPoint, nearPoint)) };
+    
+    // Only the part of the ray inside the occupied height range can hit anything
+    float tStart = 0.0f;
+    float tEnd = Vector3Distance(nearPoint, farPoint);
+    float minY = engine->gridMinY - ENTITY_PICK_MAX_EXTENT;
+    float maxY = engine->gridMaxY + ENTITY_PICK_MAX_EXTENT;
+    if (fabsf(ray.direction.y) < 1e-6f) {
+        if (ray.position.y < minY || ray.position.y > maxY) return NULL;
+    } else {
+        float ta = (minY - ray.position.y) / ray.direction.y;
+        float tb = (maxY - ray.position.y) / ray.direction.y;
+        tStart = fmaxf(tStart, fminf(ta, tb));
+        tEnd = fminf(tEnd, fmaxf(ta, tb));
+        if (tStart > tEnd) return NULL;
+    }
+    
+    // Grid DDA setup, in unclamped cell coordinates
+    Vector3 start = Vector3Add(ray.position, Vector3Scale(ray.direction, tStart));
+    int cx = (int)floorf(start.x / ENTITY_GRID_CELL_SIZE) + ENTITY_GRID_DIM / 2;
+    int cz = (int)floorf(start.z / ENTITY_GRID_CELL_SIZE) + ENTITY_GRID_DIM / 2;
+    int stepX = (ray.direction.x >= 0.0f) ? 1 : -1;
+    int stepZ = (ray.direction.z >= 0.0f) ? 1 : -1;
+    float deltaX = (ray.direction.x != 0.0f) ? fabsf(ENTITY_GRID_CELL_SIZE / ray.direction.x) : INFINITY;
+    float deltaZ = (ray.direction.z != 0.0f) ? fabsf(ENTITY_GRID_CELL_SIZE / ray.direction.z) : INFINITY;
+    float boundaryX = (cx - ENTITY_GRID_DIM / 2 + (stepX > 0)) * ENTITY_GRID_CELL_SIZE;
+    float boundaryZ = (cz - ENTITY_GRID_DIM / 2 + (stepZ > 0)) * ENTITY_GRID_CELL_SIZE;
+    float nextX = (ray.direction.x != 0.0f) ? tStart + (boundaryX - start.x) / ray.direction.x : INFINITY;
+    float nextZ = (ray.direction.z != 0.0f) ? tStart + (boundaryZ - start.z) / ray.direction.z : INFINITY;
+    
+    Entity* best = NULL;
+    float bestDistance = INFINITY;
+    for (;;) {
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int x = cx + dx;
+                int z = cz + dz;
+                if (x < 0) x = 0;
+                if (x > ENTITY_GRID_DIM - 1) x = ENTITY_GRID_DIM - 1;
+                if (z < 0) z = 0;
+                if (z > ENTITY_GRID_DIM - 1) z = ENTITY_GRID_DIM - 1;
+                
+                for (int slot = engine->gridHeads[z * ENTITY_GRID_DIM + x]; slot >= 0;
+                     slot = engine->entities[slot].gridNext) {
+                    Entity* entity = &engine->entities[slot];
+                    RayCollision hit = GetRayCollisionBox(ray, Entity_GetBounds(entity));
+                    if (hit.hit && hit.distance < bestDistance) {
+                        best = entity;
+                        bestDistance = hit.distance;
+                    }
+                }
+            }
+        }
         
-        Entity* entity = &engine->entities[i];
-        Vector2 screenPos = GetWorldToScreen(entity->position, engine->camera);
+        float exit = fminf(nextX, nextZ);
+        if (bestDistance <= exit || exit >= tEnd) break;
         
-        if (screenPos.x >= minX && screenPos.x <= maxX &&
-            screenPos.y >= minY && screenPos.y <= maxY) {
-            entity->selected = true;
+        if (nextX < nextZ) {
+            cx += stepX;
+            nextX += deltaX;
+        } else {
+            cz += stepZ;
+            nextZ += deltaZ;
         }
     }
-}
\ No newline at end of file
+    
+    return best;
+}
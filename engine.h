@@ -17,6 +17,15 @@
 #define DEFAULT_WINDOW_HEIGHT 1080
 #define DEFAULT_FPS 60
 
+// Idle rendering (menus and pause): redraw only on input or while animating
+#define IDLE_POLL_INTERVAL (1.0 / 30.0)  // Input polling rate while no frame is drawn
+#define IDLE_LINGER_TIME 0.5             // Keep drawing this long after the last input
+#define IDLE_REFRESH_INTERVAL 1.0        // Redraw at least this often while idle
+
+// Frame pacing
+#define PACING_SPIN_NS 2000000LL         // Limiter sleeps until this close to the deadline, then spins
+#define PACING_LATCH_MARGIN_NS 1500000LL // Late latch safety margin before the predicted vblank
+
 // Internal rendering resolution options for different aspect ratios
 // 16:9 aspect ratio (most common for modern monitors)
 #define INTERNAL_RENDER_WIDTH_16_9 640
@@ -38,6 +47,55 @@
 #define INTERNAL_RENDER_WIDTH 640
 #define INTERNAL_RENDER_HEIGHT 360
 
+// 3D scene scale relative to the internal resolution (UI is unaffected)
+#define SCENE_SCALE_MIN 0.5f
+#define SCENE_SCALE_STEP 0.25f
+
+// Render statistics
+#define RENDER_STATS_MAX_ZONES 16
+#define RENDER_STATS_BATCH_BUFFERS 4  // Lets flushes inside a zone be counted
+#ifndef BUILD_ID
+#define BUILD_ID "unknown"
+#endif
+
+// Frame profiler (compiled out of release builds, which define NDEBUG,
+// unless ENABLE_PROFILER is defined to get trace captures from a release build)
+#if !defined(NDEBUG) || defined(ENABLE_PROFILER)
+#define PROFILER_ENABLED
+#endif
+#define PROFILER_HISTORY_FRAMES 240
+#define PROFILER_MAX_ZONES 32
+#define PROFILER_MAX_EVENTS 128        // Zone instances recorded per frame
+#define PROFILER_MAX_COUNTERS 16       // Counter samples recorded per frame
+#define PROFILER_MAX_DEPTH 16
+#define PROFILER_CAPTURE_FRAMES 600    // Default trace length for the F8 hotkey
+#define PROFILER_MAX_CAPTURE_FRAMES 7200
+#define PROFILER_THREAD_EVENTS_PER_FRAME 16  // Worker thread zones a capture keeps per frame
+
+// Frame time telemetry
+#define TELEMETRY_BUCKETS 1024
+#define TELEMETRY_FRAME_BUDGET_US (1200000 / DEFAULT_FPS)  // One frame plus 20% for vsync jitter
+#define STARTUP_MAX_PHASES 16
+#define STARTUP_TARGET_MS 150.0         // Process start to first presented frame
+
+// Software audio mixer
+#define AUDIO_SAMPLE_RATE 22050
+#define AUDIO_MAX_SOUNDS 64
+#define AUDIO_MAX_VOICES 32
+#define AUDIO_QUEUE_SIZE 256           // Play requests in flight (power of two)
+#define AUDIO_BUFFER_FRAMES 512        // Frames mixed per block (about 23ms)
+#define AUDIO_CHANNELS 2               // Interleaved stereo output
+#define AUDIO_REFERENCE_DISTANCE 10.0f // Positional sounds play at full volume inside this radius
+#define AUDIO_ROLLOFF 1.0f             // Inverse-distance falloff beyond the reference distance
+
+// Synthesized sound bank cache
+#define SYNTH_BANK_PATH "sounds.bank"
+#define SYNTH_BANK_VERSION 1           // Bump when synthesis output changes
+
+// CRT post-processing settings
+#define CRT_SCANLINE_ALPHA 30        // Darkening of every second line (0-255)
+#define CRT_CURVATURE_AMOUNT 0.08f   // Barrel distortion strength
+
 // Camera settings
 #define CAMERA_MOUSE_SENSITIVITY 0.003f
 #define CAMERA_ZOOM_SPEED 0.1f
@@ -53,15 +111,44 @@
 #define ISO_CAMERA_MIN_HEIGHT 10.0f
 #define ISO_CAMERA_MAX_HEIGHT 100.0f
 #define ISO_CAMERA_ZOOM_SPEED 3.0f
+#define ISO_CAMERA_CLICK_SLOP 3.0f   // Drags shorter than this (canvas pixels) pick instead of box selecting
 
 // Entity system
-#define MAX_ENTITIES 1000
+#ifndef MAX_ENTITIES
+#define MAX_ENTITIES 10240  // Room for the --stress cubes scene; make bench raises it to 65536
+#endif
 #define MAX_CONTROL_GROUPS 10
+#define MAX_CONTROL_GROUP_SIZE 1024
+
+// Entity ids pack the slot into the low bits and a per-slot generation above
+// it, so Entity_GetById() is one array access and ids of destroyed entities miss
+#define ENTITY_ID_SLOT_BITS 16
+#define ENTITY_ID_SLOT_MASK ((1 << ENTITY_ID_SLOT_BITS) - 1)
+#define ENTITY_ID_MAX_GENERATION 32767
+#if MAX_ENTITIES > (1 << ENTITY_ID_SLOT_BITS)
+#error "MAX_ENTITIES does not fit in ENTITY_ID_SLOT_BITS"
+#endif
+
+// Entity spatial grid over the XZ plane; positions outside it land in the edge cells
+#define ENTITY_GRID_DIM 128
+#define ENTITY_GRID_CELL_SIZE 2.0f
+#define ENTITY_GRID_CELLS (ENTITY_GRID_DIM * ENTITY_GRID_DIM)
+#define ENTITY_PICK_MAX_EXTENT ENTITY_GRID_CELL_SIZE  // Largest half-size Entity_Pick() can hit off-center
+
+// Text layout cache
+#define TEXT_CACHE_SIZE 128          // Retained layouts (power of two)
+#define TEXT_MAX_LENGTH 96           // Longest cached string, including terminator
+#define TEXT_FIELD_KEYS 8            // Values a TextField line can be keyed on
 
 // Gamepad settings
 #define MAX_GAMEPADS 4
 #define GAMEPAD_DEAD_ZONE 0.15f
 #define GAMEPAD_TRIGGER_THRESHOLD 0.1f
+#define GAMEPAD_AXIS_COUNT 6           // Sticks and triggers, indexed by GAMEPAD_AXIS_*
+
+// Input bindings
+#define INPUT_MAX_BINDINGS 128
+#define INPUT_EVENT_QUEUE_SIZE 128     // Timestamped action changes kept between frames
 
 // =====================================
 // Type Definitions
@@ -107,12 +194,27 @@ typedef struct {
     Vector2 selectionEnd;
 } IsometricCamera;
 
+// Camera math for the current frame, published by Camera_Apply()
+typedef struct {
+    Matrix view;
+    Matrix projection;
+    Matrix viewProjection;
+    Matrix inverseViewProjection;
+    Vector3 right;                 // Unit basis in world space
+    Vector3 up;
+    Vector3 forward;
+    int width;                     // UI canvas the projection maps onto
+    int height;
+} CameraMatrices;
+
 // Universal entity structure
 typedef struct Entity {
     int id;
+    int generation;                // Bumped each time the slot is reused, kept across Entity_Create()
     EntityType type;
     bool active;
-    bool selected;
+    bool selected;                 // Read-only; change it with Entity_Select()
+    int selectedIndex;             // Position in EngineState.selection, -1 when not selected
 
     // Transform
     Vector3 position;
@@ -126,7 +228,8 @@ typedef struct Entity {
 
     // Visual
     Color color;
-    Model* model;  // Optional 3D model
+    Model* model;  // Optional 3D model, set with Entity_SetModel()
+    BoundingBox localBounds;  // Unscaled bounds around position: the model's, or a unit cube
     Texture2D* texture;  // Optional texture
 
     // Gameplay
@@ -137,16 +240,255 @@ typedef struct Entity {
 
     // Custom data pointer for game-specific data
     void* customData;
+
+    // Spatial grid links (entity slots, -1 for none), kept by Entity_SetPosition()
+    int gridCell;
+    int gridPrev;
+    int gridNext;
 } Entity;
 
+// How a box selection combines with the current selection
+typedef enum {
+    SELECT_REPLACE,
+    SELECT_ADD,                    // Shift held
+    SELECT_REMOVE                  // Ctrl held
+} SelectMode;
+
 // Control group for RTS-style games
 typedef struct {
-    int entityIds[MAX_ENTITIES];
+    int entityIds[MAX_CONTROL_GROUP_SIZE];
     int entityCount;
     bool active;
     Vector3 center;
 } ControlGroup;
 
+// Pre-laid-out glyph quad (texture coordinates and offset from the text origin)
+typedef struct {
+    float u0, v0, u1, v1;
+    float x, y, width, height;
+} TextGlyphQuad;
+
+// Measured, laid-out single line of default-font text
+typedef struct {
+    char text[TEXT_MAX_LENGTH];
+    int fontSize;
+    int width;                     // Same value MeasureText() would return
+    int glyphCount;
+    TextGlyphQuad glyphs[TEXT_MAX_LENGTH];
+} TextLayout;
+
+// Retained text for a value or formatted line; only re-laid out when it changes
+typedef struct {
+    bool valid;
+    double value;
+    double keys[TEXT_FIELD_KEYS];  // Values a formatted line was built from (Text_FieldChanged)
+    int keyCount;
+    TextLayout layout;
+} TextField;
+
+// Timings kept in telemetry histograms
+typedef enum {
+    TELEMETRY_FRAME,               // Start of one drawn frame to the next
+    TELEMETRY_UPDATE,              // Game simulation step
+    TELEMETRY_RENDER,              // CPU time building and submitting a frame
+    TELEMETRY_PRESENT_JITTER,      // Change in swap-to-swap time between consecutive frames
+    TELEMETRY_INPUT_TO_UPDATE,     // Steering press seen to the turn applied (latency probe)
+    TELEMETRY_INPUT_TO_DRAW,       // ... to the turned rider drawn
+    TELEMETRY_INPUT_TO_PRESENT,    // ... to the buffer swap returning
+    TELEMETRY_METRIC_COUNT
+} TelemetryMetric;
+
+// How frames are paced (see Engine_SetPacing())
+typedef enum {
+    PACING_VSYNC,                  // Swap waits for vertical blank, raylib's limiter as a fallback
+    PACING_UNCAPPED,               // No waiting at all, for benchmarks
+    PACING_LIMITER,                // Vsync off, own sleep + spin limiter
+    PACING_MODE_COUNT
+} PacingMode;
+
+// Points a steering press passes on its way to the screen
+typedef enum {
+    LATENCY_INPUT,                 // Input_Update() sees the press
+    LATENCY_UPDATE,                // UpdateLineRider() applies the turn
+    LATENCY_DRAW,                  // The rider has been drawn
+    LATENCY_PRESENT,               // EndDrawing() has swapped the buffers
+    LATENCY_STAGE_COUNT
+} LatencyStage;
+
+// Named actions; the binding table maps keys, buttons and axes onto them
+typedef enum {
+    // Game
+    ACTION_TURN_LEFT,
+    ACTION_CONFIRM,
+    ACTION_BACK,
+    ACTION_CANCEL,                 // Opens and closes the pause menu, quits from the main menu
+    ACTION_PAUSE,
+    ACTION_MENU_LEFT,
+    ACTION_MENU_RIGHT,
+    ACTION_TOGGLE_SOUND,
+    ACTION_TOGGLE_FPS,
+
+    // Camera
+    ACTION_CAMERA_MODE,
+    ACTION_CAMERA_RESET,
+    ACTION_CAMERA_ROTATE,          // Held while the mouse moves
+    ACTION_CAMERA_DRAG,            // Held while the mouse moves
+    ACTION_PAN_LEFT,
+    ACTION_PAN_RIGHT,
+    ACTION_PAN_UP,
+    ACTION_PAN_DOWN,
+    ACTION_PAN_FAST,
+    ACTION_LOOK_LEFT,
+    ACTION_LOOK_RIGHT,
+    ACTION_LOOK_UP,
+    ACTION_LOOK_DOWN,
+    ACTION_ZOOM_IN,
+    ACTION_ZOOM_OUT,
+    ACTION_SELECT,
+    ACTION_SELECT_ADD,             // Held while a box selection ends
+    ACTION_SELECT_REMOVE,
+
+    // Engine and debug toggles
+    ACTION_TOGGLE_DEBUG_INFO,
+    ACTION_TOGGLE_UI,
+    ACTION_TOGGLE_FULLSCREEN,
+    ACTION_TOGGLE_INTERNAL_RESOLUTION,
+    ACTION_TOGGLE_ASPECT_RATIO,
+    ACTION_TOGGLE_SCANLINES,
+    ACTION_TOGGLE_CURVATURE,
+    ACTION_TOGGLE_VIGNETTE,
+    ACTION_CYCLE_SCENE_SCALE,
+    ACTION_TOGGLE_STATS_RECORDING,
+    ACTION_TOGGLE_TRACE_CAPTURE,
+    ACTION_TOGGLE_LATENCY_PROBE,
+    ACTION_COUNT
+} InputAction;
+
+// Kind of control a binding reads
+typedef enum {
+    INPUT_KEY,
+    INPUT_MOUSE_BUTTON,
+    INPUT_GAMEPAD_BUTTON,
+    INPUT_GAMEPAD_AXIS_POSITIVE,   // Active gamepad axis, positive half
+    INPUT_GAMEPAD_AXIS_NEGATIVE
+} InputSource;
+
+typedef struct {
+    InputAction action;
+    InputSource source;
+    int code;                      // KEY_*, MOUSE_BUTTON_*, GAMEPAD_BUTTON_* or GAMEPAD_AXIS_*
+    int modifier;                  // Key that must also be held, KEY_NULL for none
+} InputBinding;
+
+// Everything the game and engine read about input for one frame. Built once
+// by Input_Update(), or copied from a replay or bot (see Input_SetSource()).
+typedef struct {
+    bool down[ACTION_COUNT];
+    bool pressed[ACTION_COUNT];    // Down this frame but not the previous one
+    bool released[ACTION_COUNT];
+    float value[ACTION_COUNT];     // 0-1: analog for axes, 1 for keys and buttons
+    float held[ACTION_COUNT];      // Average value over the time since the last frame, from timestamped changes
+    Vector2 mousePosition;         // UI canvas space
+    Vector2 mouseScreenPosition;   // Window pixels
+    Vector2 mouseDelta;
+    float mouseWheel;
+    float gamepadAxes[GAMEPAD_AXIS_COUNT];  // Active gamepad, dead zone applied, triggers 0-1
+    bool activity;                 // Window resize, mouse or stick change, or (while idle) any key or button; wakes idle rendering
+} InputFrame;
+
+// Where the audio mixer sends its output
+typedef enum {
+    AUDIO_SINK_STREAM,             // raylib AudioStream on the sound device
+    AUDIO_SINK_WAV,                // WAV file, paced in real time
+    AUDIO_SINK_NULL                // Mixed and discarded (no device)
+} AudioSinkType;
+
+// How the mixer treats overlapping plays of one sound
+typedef struct {
+    float volume;
+    int maxVoices;                 // Instances that may play at once; the oldest is restarted past this
+    int priority;                  // May steal voices from sounds with equal or lower priority
+    float retriggerInterval;       // Plays closer together than this (seconds) are dropped
+} AudioSoundSettings;
+
+// Extra source mixed into every block, e.g. music; adds into the stereo buses
+typedef void (*AudioMixCallback)(float* left, float* right, int frames);
+
+// Mixer CPU cost since the previous Audio_GetStats() call
+typedef struct {
+    double mixMs;                  // Mean time to render AUDIO_BUFFER_FRAMES frames, music included
+    double callbackMs;             // Mean AudioMixCallback share of that
+    double peakLoad;               // Worst block render time over the audio time it produced
+} AudioStats;
+
+// What the game wants the music to do
+typedef struct {
+    float tempo;                   // Beats per minute
+    float intensity;               // 0 = bass only, 1 = every layer at full density
+    float volume;                  // 0 silences the music
+} MusicState;
+
+// Oscillator shapes for synthesized effects
+typedef enum {
+    SYNTH_WAVE_SINE,
+    SYNTH_WAVE_SQUARE,
+    SYNTH_WAVE_TRIANGLE,
+    SYNTH_WAVE_SAW,
+    SYNTH_WAVE_NOISE
+} SynthWaveform;
+
+// One synthesized effect; times are in seconds
+typedef struct {
+    SynthWaveform waveform;
+    float frequency;               // Start frequency in Hz
+    float frequencyEnd;            // Linear sweep target (equal to frequency for a flat tone)
+    float duration;
+    float attack;
+    float decay;
+    float sustain;                 // Level held after the decay, 0-1
+    float release;
+    float fmRatio;                 // Modulator frequency as a multiple of the carrier
+    float fmIndex;                 // Modulation depth in radians (0 disables FM)
+    float volume;                  // Peak amplitude, 0-1
+} SynthParams;
+
+// Percentiles read back from a telemetry histogram
+typedef struct {
+    long long count;
+    long long overBudget;          // Samples longer than TELEMETRY_FRAME_BUDGET_US (frame, update, render only)
+    float meanMs;
+    float p50Ms;
+    float p95Ms;
+    float p99Ms;
+    float maxMs;
+} TelemetrySummary;
+
+// rlgl submission counters for one named renderer
+typedef struct {
+    const char* name;
+    int drawCalls;
+    int vertices;
+    int flushes;                   // Batch filled up or state change forced a submit
+    int forcedFlushes;             // Submits added by the zone boundaries themselves
+    int textureSwitches;
+    bool partial;                  // A flush inside the zone hid some of its draws
+} RenderZoneStats;
+
+// Per-frame rlgl submission counters
+typedef struct {
+    RenderZoneStats zones[RENDER_STATS_MAX_ZONES];
+    int zoneCount;
+    int activeZone;                // -1 outside of a zone
+    int startBuffer;               // Batch buffer index when the active zone began
+    unsigned int lastTextureId;    // Last texture drawn, to count switches across zones
+    int drawCalls;                 // Frame totals over all zones
+    int vertices;
+    int flushes;
+    int forcedFlushes;             // Zone boundary submits, including unzoned draws before a zone
+    int textureSwitches;
+    int targetSwitches;            // Render texture begin/end
+} RenderFrameStats;
+
 // Engine state
 typedef struct {
     // Window
@@ -157,10 +499,12 @@ typedef struct {
     // Dynamic resolution settings
     int internalWidth;     // Actual internal render width based on aspect ratio
     int internalHeight;    // Actual internal render height based on aspect ratio
+    float sceneScale;      // 3D render target size as a fraction of the internal resolution
     float monitorAspectRatio;  // Detected monitor aspect ratio
 
     // Camera
     Camera3D camera;
+    CameraMatrices cameraMatrices; // Refreshed from camera by Camera_Apply()
     ViewMode viewMode;
     OrbitCamera orbitCamera;
     IsometricCamera isoCamera;
@@ -168,43 +512,83 @@ typedef struct {
     // Entities
     Entity entities[MAX_ENTITIES];
     int entityCount;
-    int nextEntityId;
+    int entityFreeHint;            // No free slot below this one
+    int gridHeads[ENTITY_GRID_CELLS];  // First entity slot in each cell, -1 for none
+    float gridMinY;                // Height range of every position the grid has seen
+    float gridMaxY;
+    int hoveredEntityId;           // Entity under the cursor in isometric view, 0 for none
+    int selection[MAX_ENTITIES];   // Slots of the selected entities, dense and unordered
+    int selectedCount;
 
     // Control groups
     ControlGroup controlGroups[MAX_CONTROL_GROUPS];
 
     // Input state
-    bool mouseLeftPressed;
-    bool mouseRightPressed;
-    bool mouseMiddlePressed;
-    Vector2 mousePosition;
-    Vector2 mouseDelta;
-    float mouseWheel;
+    InputFrame input;              // This frame's actions; read this instead of polling raylib
+    const InputFrame* inputSource; // Replay or bot frame used instead of the devices, NULL for none
 
     // Gamepad state
     int activeGamepad;  // Currently active gamepad ID (-1 if none)
     bool gamepadConnected[MAX_GAMEPADS];
-    Vector2 gamepadLeftStick[MAX_GAMEPADS];
-    Vector2 gamepadRightStick[MAX_GAMEPADS];
-    float gamepadLeftTrigger[MAX_GAMEPADS];
-    float gamepadRightTrigger[MAX_GAMEPADS];
 
     // Engine state
     bool running;
     float deltaTime;
     float totalTime;
+    double lastFrameTime;          // GetTime() at the previous Engine_BeginFrame
+    long long frameStartNs;        // When the current drawn frame started, 0 after idle frames
+
+    // Frame pacing
+    PacingMode pacingMode;
+    bool lateLatch;                // Start each frame as late as the predicted CPU time allows
+    long long pacingPeriodNs;      // Limiter period, or the monitor refresh period with vsync
+    long long pacingDeadlineNs;    // Next limiter deadline
+    long long pacingWorkNs;        // Predicted CPU time from the latch to the swap (decaying maximum)
+    long long latchNs;             // When the current frame's input was latched
+    long long lastSwapNs;          // When EndDrawing() last returned
+    long long lastSwapIntervalNs;  // Previous swap-to-swap time, 0 after idle frames
+
+    // Idle rendering
+    bool idle;                     // Set by the game when nothing animates on its own
+    double lastActivityTime;       // Last input/resize seen, for the redraw linger window
+    double lastPresentTime;        // Last time a frame was actually drawn
+    int idleSkippedFrames;         // Frames skipped since the last drawn frame
 
     // Debug/display options
     bool showDebugInfo;
     bool showUI;
+    double uiStartTime;            // When 2D UI rendering began this frame
+    float uiCpuTime;               // CPU time spent building the last frame's UI
 
     // Low resolution rendering
-    RenderTexture2D renderTarget;  // Internal render texture at low resolution
+    RenderTexture2D renderTarget;  // 3D scene render texture at low resolution
     bool useInternalResolution;    // Whether to use internal resolution rendering
     bool showScanlines;            // Whether to show CRT scanline effect
     bool maintainAspectRatio;      // Whether to maintain aspect ratio (letterbox) or stretch to fill
     Rectangle sourceRect;           // Source rectangle for render texture
     Rectangle destRect;             // Destination rectangle for fullscreen
+
+    // CRT post-processing (applied during the render texture upscale)
+    Shader crtShader;              // Scanline/curvature/vignette fragment shader
+    bool crtShaderReady;           // False when the GL context can't run shaders
+    int crtOutputSizeLoc;          // Uniform locations in crtShader
+    int crtScanlinesLoc;
+    int crtCurvatureLoc;
+    int crtVignetteLoc;
+    Texture2D scanlineTexture;     // 1x2 tile for the shaderless scanline fallback
+    bool showCurvature;            // Whether to bend the image like a CRT tube
+    bool showVignette;             // Whether to darken the screen corners
+
+    // Render statistics (collected while the debug overlay or recording is on)
+    RenderFrameStats renderStats;      // Frame being recorded
+    RenderFrameStats lastRenderStats;  // Previous complete frame, shown in the overlay
+    bool renderStatsRecording;         // Writing per-frame rows to CSV (F7)
+    int renderStatsFrame;              // Frame number within the recording
+    bool writeTelemetry;               // --telemetry: write the summary files on exit
+
+    // Input-to-present latency probe (F9 or --latency)
+    bool measureLatency;
+    long long latencyMarks[LATENCY_STAGE_COUNT];  // Times the pending probe reached each stage, 0 = not yet
 } EngineState;
 
 // =====================================
@@ -216,10 +600,21 @@ EngineState* Engine_Init(int width, int height, const char* title);
 void Engine_Shutdown(EngineState* engine);
 
 // Main loop
-void Engine_BeginFrame(EngineState* engine);
-void Engine_End3D(EngineState* engine);  // End 3D mode, begin 2D UI rendering
+bool Engine_BeginFrame(EngineState* engine);  // Returns false when the frame is skipped (idle)
+void Engine_End3D(EngineState* engine);  // End 3D mode, present the scene, begin native-resolution UI
 void Engine_EndFrame(EngineState* engine);
 bool Engine_ShouldClose(EngineState* engine);
+void Engine_SetIdle(EngineState* engine, bool idle);  // Enable on-demand rendering
+
+// Frame pacing
+void Engine_SetPacing(EngineState* engine, PacingMode mode, int targetFps, bool lateLatch);
+void Engine_LatchFrame(EngineState* engine);  // Late latch wait; call right before Input_Update()
+const char* Engine_GetPacingName(PacingMode mode);
+
+// Resolution
+void Engine_SetSceneScale(EngineState* engine, float scale);
+int Engine_GetUIWidth(EngineState* engine);   // Logical size of the 2D UI canvas
+int Engine_GetUIHeight(EngineState* engine);
 
 // =====================================
 // Camera Functions
@@ -230,21 +625,27 @@ void Camera_InitIsometric(IsometricCamera* cam, Vector3 target, float height);
 void Camera_UpdateOrbit(EngineState* engine);
 void Camera_UpdateIsometric(EngineState* engine);
 void Camera_SetMode(EngineState* engine, ViewMode mode);
-void Camera_Apply(EngineState* engine);
+void Camera_Apply(EngineState* engine);  // Computes cameraMatrices once the camera is final for the frame
 
 // =====================================
 // Entity Management
 // =====================================
 
 Entity* Entity_Create(EngineState* engine, EntityType type);
+void Entity_ResetAll(EngineState* engine);  // Destroys every entity without freeing custom data
+void Entity_SetPosition(EngineState* engine, Entity* entity, Vector3 position);  // Move and keep the grid current
+void Entity_SetScale(Entity* entity, Vector3 scale);  // Clamped so picking can still reach the bounds
+void Entity_SetModel(Entity* entity, Model* model);  // NULL draws a cube; caches the model's bounds
 void Entity_Destroy(EngineState* engine, int entityId);
 Entity* Entity_GetById(EngineState* engine, int entityId);
 void Entity_Update(EngineState* engine, Entity* entity);
 void Entity_Render(Entity* entity);
+void Entity_RenderAll(EngineState* engine);
 
 // Selection and control
-void Entity_Select(Entity* entity, bool selected);
-void Entity_SelectInBox(EngineState* engine, Vector2 start, Vector2 end);
+void Entity_Select(EngineState* engine, Entity* entity, bool selected);
+void Entity_SelectInBox(EngineState* engine, Vector2 start, Vector2 end, SelectMode mode);
+Entity* Entity_Pick(EngineState* engine, Vector2 screenPos);  // Nearest entity under a UI canvas point
 void Entity_ClearSelection(EngineState* engine);
 int Entity_GetSelectedCount(EngineState* engine);
 
@@ -258,26 +659,17 @@ Vector3 ControlGroup_GetCenter(EngineState* engine, int groupId);
 // Input Functions
 // =====================================
 
+// Polls the devices once and builds engine->input; call at the start of each loop iteration
 void Input_Update(EngineState* engine);
-bool Input_IsKeyPressed(int key);
-bool Input_IsKeyDown(int key);
-bool Input_IsKeyReleased(int key);
-bool Input_IsMouseButtonPressed(int button);
-bool Input_IsMouseButtonDown(int button);
-bool Input_IsMouseButtonReleased(int button);
-Vector2 Input_GetMousePosition(void);
-Vector2 Input_GetMouseDelta(void);
-float Input_GetMouseWheel(void);
+void Input_SetSource(EngineState* engine, const InputFrame* frame);  // NULL returns to the devices
+void Input_Sample(EngineState* engine);  // Extra mid-frame poll that timestamps action changes
+
+// Rebinding
+void Input_ResetBindings(void);                // Restore the default table
+void Input_ClearBindings(InputAction action);
+bool Input_AddBinding(InputBinding binding);   // False when the table is full
 
 // Gamepad functions
-bool Input_IsGamepadAvailable(int gamepad);
-bool Input_IsGamepadButtonPressed(int gamepad, int button);
-bool Input_IsGamepadButtonDown(int gamepad, int button);
-bool Input_IsGamepadButtonReleased(int gamepad, int button);
-Vector2 Input_GetGamepadLeftStick(int gamepad);
-Vector2 Input_GetGamepadRightStick(int gamepad);
-float Input_GetGamepadLeftTrigger(int gamepad);
-float Input_GetGamepadRightTrigger(int gamepad);
 int Input_GetActiveGamepad(EngineState* engine);
 void Input_UpdateGamepads(EngineState* engine);
 
@@ -288,6 +680,120 @@ void Input_UpdateGamepads(EngineState* engine);
 void Render_SelectionBox(Vector2 start, Vector2 end);
 void Render_DebugInfo(EngineState* engine);
 
+// Post-processing for the internal resolution upscale
+void Render_InitPostProcess(EngineState* engine);
+void Render_UnloadPostProcess(EngineState* engine);
+void Render_PresentTarget(EngineState* engine);
+
+// Draw call, vertex and batch flush counters attributed to named zones
+void Render_StatsBeginFrame(EngineState* engine);
+void Render_StatsEndFrame(EngineState* engine);
+void Render_StatsBeginZone(EngineState* engine, const char* name);
+void Render_StatsEndZone(EngineState* engine);
+void Render_StatsTargetSwitch(EngineState* engine);
+void Render_StatsToggleRecording(EngineState* engine);
+void Render_UnloadStats(EngineState* engine);
+
+// =====================================
+// Telemetry Functions
+// =====================================
+
+void Telemetry_Record(TelemetryMetric metric, long long ns);
+void Telemetry_GetSummary(TelemetryMetric metric, TelemetrySummary* summary);
+const char* Telemetry_GetMetricName(TelemetryMetric metric);
+void Telemetry_Reset(void);
+void Telemetry_WriteSummary(EngineState* engine);
+void Telemetry_StartLatency(EngineState* engine, long long inputNs);  // Begin a probe at a past input time
+void Telemetry_MarkLatency(EngineState* engine, LatencyStage stage);
+
+// Startup phases: each mark closes the phase that began at the previous mark
+void Telemetry_BeginStartup(void);
+void Telemetry_MarkStartup(const char* phase);  // Name must be a string literal
+void Telemetry_ReportStartup(void);
+
+// =====================================
+// Audio Functions
+// =====================================
+
+// Sounds are mono 16-bit at AUDIO_SAMPLE_RATE and must be added before Audio_Start();
+// the samples must stay valid until Audio_Shutdown(). Returns the sound ID or -1.
+int Audio_AddSound(const short* samples, int frameCount, const AudioSoundSettings* settings);
+bool Audio_Start(AudioSinkType sink, const char* wavPath);  // Stream falls back to WAV or null
+void Audio_Play(int sound, float volume);  // Lock-free, allocation-free; game thread only
+void Audio_PlayAt(int sound, float volume, Vector3 position);  // Attenuated and panned by the mixer
+void Audio_SetListener(const Camera3D* camera);  // Listens at the camera target; once per frame
+void Audio_SetMixCallback(AudioMixCallback callback);  // Before Audio_Start(); runs on the mixer
+void Audio_GetStats(AudioStats* stats);
+AudioSinkType Audio_GetSink(void);
+void Audio_Shutdown(void);
+
+// =====================================
+// Music Functions
+// =====================================
+
+void Music_SetState(const MusicState* state);  // Lock-free; game thread, once per frame
+void Music_Render(float* left, float* right, int frames);  // AudioMixCallback, mixer thread only
+
+// =====================================
+// Synthesis Functions
+// =====================================
+
+int Synth_GetFrameCount(const SynthParams* params);          // Mono frames at AUDIO_SAMPLE_RATE
+void Synth_Render(const SynthParams* params, short* output);  // Writes Synth_GetFrameCount() frames
+unsigned int Synth_Hash(const SynthParams* params);
+
+// Loads every sound from the cache file, or renders them and rewrites the cache
+bool Synth_LoadBank(const SynthParams* params, int count, const char* cachePath);
+const short* Synth_GetBankSamples(int index, int* frameCount);  // Valid until Synth_UnloadBank()
+void Synth_UnloadBank(void);
+
+// =====================================
+// Text Functions
+// =====================================
+
+// Cached layouts for the default font (DrawText/MeasureText semantics)
+const TextLayout* Text_Layout(const char* text, int fontSize);
+const TextLayout* Text_LayoutInt(TextField* field, const char* format, int value, int fontSize);
+const TextLayout* Text_LayoutFloat(TextField* field, const char* format, float value, int fontSize);
+const TextLayout* Text_LayoutString(TextField* field, const char* text, int fontSize);  // Retained per call site, bypasses the cache
+bool Text_FieldChanged(TextField* field, const double* keys, int count, int fontSize);  // True when the line needs formatting again
+void Text_DrawLayout(const TextLayout* layout, int posX, int posY, Color color);
+void Text_Draw(const char* text, int posX, int posY, int fontSize, Color color);
+void Text_DrawCentered(const char* text, int centerX, int posY, int fontSize, Color color);
+int Text_Measure(const char* text, int fontSize);
+void Text_BeginFrame(void);
+void Text_GetStats(int* cached, int* layoutsThisFrame);
+
+// =====================================
+// Profiler Functions
+// =====================================
+
+// Use the PROFILE_* macros so zones disappear from release builds
+#ifdef PROFILER_ENABLED
+void Profiler_FrameMark(void);              // Close the previous frame and start the next
+void Profiler_BeginZone(const char* name);  // Name must outlive the profiler (string literal); other threads only reach traces
+void Profiler_EndZone(void);
+void Profiler_Counter(const char* name, double value);  // Sampled once per frame
+void Profiler_DrawGraph(int x, int y, int width, int height);
+int Profiler_GetZoneAverages(const char** names, double* averageMs, int maxZones);  // Returns zone count
+void Profiler_Shutdown(void);
+
+// Chrome trace capture: frames are buffered in memory and written on stop
+bool Profiler_StartCapture(int frameCount);
+void Profiler_StopCapture(void);
+bool Profiler_IsCapturing(void);
+int Profiler_GetCapturedFrames(void);
+#define PROFILE_FRAME() Profiler_FrameMark()
+#define PROFILE_BEGIN(name) Profiler_BeginZone(name)
+#define PROFILE_END() Profiler_EndZone()
+#define PROFILE_COUNTER(name, value) Profiler_Counter(name, value)
+#else
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END() ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#endif
+
 // =====================================
 // Utility Functions
 // =====================================
@@ -296,7 +802,15 @@ void Render_DebugInfo(EngineState* engine);
 Vector3 Utils_GetGroundPosition(Vector3 worldPos);
 Vector3 Utils_ScreenToWorld(EngineState* engine, Vector2 screenPos);
 Vector2 Utils_WorldToScreen(EngineState* engine, Vector3 worldPos);
+void Utils_WorldToScreenBatch(EngineState* engine, const Vector3* points, int count, Vector2* out);
 bool Utils_IsPointInBox(Vector2 point, Vector2 boxStart, Vector2 boxEnd);
+long long Utils_GetTimeNs(void);  // Monotonic clock in nanoseconds
+unsigned long Utils_GetThreadId(void);
+
+// Worker threads (pthreads, or the Win32 API directly)
+typedef struct UtilsThread UtilsThread;
+UtilsThread* Utils_StartThread(void (*func)(void* arg), void* arg);  // NULL on failure
+void Utils_JoinThread(UtilsThread* thread);  // Waits for the thread and frees the handle
 
 // Collision detection
 bool Utils_CheckCollisionSpheres(Vector3 pos1, float radius1, Vector3 pos2, float radius2);
@@ -4,160 +4,414 @@
 // Input System Implementation
 // =====================================
 
-void Input_Update(EngineState* engine) {
-    if (!engine) return;
-    
-    // Update mouse state
-    Vector2 rawMousePos = GetMousePosition();
-    
+// Default controls; Input_ResetBindings() copies these into the live table
+static const InputBinding defaultBindings[] = {
+    // Steering: full rate on keys and buttons, analog on the trigger and stick
+    { ACTION_TURN_LEFT, INPUT_KEY, KEY_SPACE, KEY_NULL },
+    { ACTION_TURN_LEFT, INPUT_MOUSE_BUTTON, MOUSE_BUTTON_LEFT, KEY_NULL },
+    { ACTION_TURN_LEFT, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, KEY_NULL },
+    { ACTION_TURN_LEFT, INPUT_GAMEPAD_AXIS_POSITIVE, GAMEPAD_AXIS_RIGHT_TRIGGER, KEY_NULL },
+    { ACTION_TURN_LEFT, INPUT_GAMEPAD_AXIS_NEGATIVE, GAMEPAD_AXIS_LEFT_X, KEY_NULL },
+
+    // Menus
+    { ACTION_CONFIRM, INPUT_KEY, KEY_ENTER, KEY_NULL },
+    { ACTION_CONFIRM, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, KEY_NULL },
+    { ACTION_BACK, INPUT_KEY, KEY_M, KEY_NULL },
+    { ACTION_BACK, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, KEY_NULL },
+    { ACTION_CANCEL, INPUT_KEY, KEY_ESCAPE, KEY_NULL },
+    { ACTION_PAUSE, INPUT_KEY, KEY_P, KEY_NULL },
+    { ACTION_PAUSE, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_MIDDLE_RIGHT, KEY_NULL },
+    { ACTION_MENU_LEFT, INPUT_KEY, KEY_LEFT, KEY_NULL },
+    { ACTION_MENU_LEFT, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_FACE_LEFT, KEY_NULL },
+    { ACTION_MENU_RIGHT, INPUT_KEY, KEY_RIGHT, KEY_NULL },
+    { ACTION_MENU_RIGHT, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_FACE_RIGHT, KEY_NULL },
+    { ACTION_TOGGLE_SOUND, INPUT_KEY, KEY_S, KEY_NULL },
+    { ACTION_TOGGLE_FPS, INPUT_KEY, KEY_F, KEY_NULL },
+
+    // Camera
+    { ACTION_CAMERA_MODE, INPUT_KEY, KEY_TAB, KEY_NULL },
+    { ACTION_CAMERA_MODE, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_RIGHT_FACE_UP, KEY_NULL },
+    { ACTION_CAMERA_RESET, INPUT_KEY, KEY_R, KEY_NULL },
+    { ACTION_CAMERA_RESET, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_MIDDLE_LEFT, KEY_NULL },
+    { ACTION_CAMERA_ROTATE, INPUT_MOUSE_BUTTON, MOUSE_BUTTON_LEFT, KEY_NULL },
+    { ACTION_CAMERA_DRAG, INPUT_MOUSE_BUTTON, MOUSE_BUTTON_MIDDLE, KEY_NULL },
+    { ACTION_PAN_LEFT, INPUT_KEY, KEY_A, KEY_NULL },
+    { ACTION_PAN_LEFT, INPUT_KEY, KEY_LEFT, KEY_NULL },
+    { ACTION_PAN_LEFT, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_FACE_LEFT, KEY_NULL },
+    { ACTION_PAN_LEFT, INPUT_GAMEPAD_AXIS_NEGATIVE, GAMEPAD_AXIS_LEFT_X, KEY_NULL },
+    { ACTION_PAN_RIGHT, INPUT_KEY, KEY_D, KEY_NULL },
+    { ACTION_PAN_RIGHT, INPUT_KEY, KEY_RIGHT, KEY_NULL },
+    { ACTION_PAN_RIGHT, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_FACE_RIGHT, KEY_NULL },
+    { ACTION_PAN_RIGHT, INPUT_GAMEPAD_AXIS_POSITIVE, GAMEPAD_AXIS_LEFT_X, KEY_NULL },
+    { ACTION_PAN_UP, INPUT_KEY, KEY_W, KEY_NULL },
+    { ACTION_PAN_UP, INPUT_KEY, KEY_UP, KEY_NULL },
+    { ACTION_PAN_UP, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_FACE_UP, KEY_NULL },
+    { ACTION_PAN_UP, INPUT_GAMEPAD_AXIS_NEGATIVE, GAMEPAD_AXIS_LEFT_Y, KEY_NULL },
+    { ACTION_PAN_DOWN, INPUT_KEY, KEY_S, KEY_NULL },
+    { ACTION_PAN_DOWN, INPUT_KEY, KEY_DOWN, KEY_NULL },
+    { ACTION_PAN_DOWN, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_FACE_DOWN, KEY_NULL },
+    { ACTION_PAN_DOWN, INPUT_GAMEPAD_AXIS_POSITIVE, GAMEPAD_AXIS_LEFT_Y, KEY_NULL },
+    { ACTION_PAN_FAST, INPUT_KEY, KEY_LEFT_SHIFT, KEY_NULL },
+    { ACTION_PAN_FAST, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_TRIGGER_1, KEY_NULL },
+    { ACTION_LOOK_LEFT, INPUT_GAMEPAD_AXIS_NEGATIVE, GAMEPAD_AXIS_RIGHT_X, KEY_NULL },
+    { ACTION_LOOK_RIGHT, INPUT_GAMEPAD_AXIS_POSITIVE, GAMEPAD_AXIS_RIGHT_X, KEY_NULL },
+    { ACTION_LOOK_UP, INPUT_GAMEPAD_AXIS_NEGATIVE, GAMEPAD_AXIS_RIGHT_Y, KEY_NULL },
+    { ACTION_LOOK_DOWN, INPUT_GAMEPAD_AXIS_POSITIVE, GAMEPAD_AXIS_RIGHT_Y, KEY_NULL },
+    { ACTION_ZOOM_IN, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_TRIGGER_1, KEY_NULL },
+    { ACTION_ZOOM_IN, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_LEFT_THUMB, KEY_NULL },
+    { ACTION_ZOOM_OUT, INPUT_GAMEPAD_AXIS_POSITIVE, GAMEPAD_AXIS_LEFT_TRIGGER, KEY_NULL },
+    { ACTION_ZOOM_OUT, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_RIGHT_THUMB, KEY_NULL },
+    { ACTION_SELECT, INPUT_MOUSE_BUTTON, MOUSE_BUTTON_LEFT, KEY_NULL },
+    { ACTION_SELECT_ADD, INPUT_KEY, KEY_LEFT_SHIFT, KEY_NULL },
+    { ACTION_SELECT_ADD, INPUT_KEY, KEY_RIGHT_SHIFT, KEY_NULL },
+    { ACTION_SELECT_REMOVE, INPUT_KEY, KEY_LEFT_CONTROL, KEY_NULL },
+    { ACTION_SELECT_REMOVE, INPUT_KEY, KEY_RIGHT_CONTROL, KEY_NULL },
+
+    // Engine and debug toggles
+    { ACTION_TOGGLE_DEBUG_INFO, INPUT_KEY, KEY_I, KEY_NULL },
+    { ACTION_TOGGLE_DEBUG_INFO, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_MIDDLE_LEFT, KEY_NULL },
+    { ACTION_TOGGLE_UI, INPUT_KEY, KEY_U, KEY_NULL },
+    { ACTION_TOGGLE_UI, INPUT_GAMEPAD_BUTTON, GAMEPAD_BUTTON_MIDDLE_RIGHT, KEY_NULL },
+    { ACTION_TOGGLE_FULLSCREEN, INPUT_KEY, KEY_F11, KEY_NULL },
+    { ACTION_TOGGLE_FULLSCREEN, INPUT_KEY, KEY_ENTER, KEY_LEFT_ALT },
+    { ACTION_TOGGLE_INTERNAL_RESOLUTION, INPUT_KEY, KEY_F1, KEY_NULL },
+    { ACTION_TOGGLE_SCANLINES, INPUT_KEY, KEY_F2, KEY_NULL },
+    { ACTION_TOGGLE_ASPECT_RATIO, INPUT_KEY, KEY_F3, KEY_NULL },
+    { ACTION_TOGGLE_CURVATURE, INPUT_KEY, KEY_F4, KEY_NULL },
+    { ACTION_TOGGLE_VIGNETTE, INPUT_KEY, KEY_F5, KEY_NULL },
+    { ACTION_CYCLE_SCENE_SCALE, INPUT_KEY, KEY_F6, KEY_NULL },
+    { ACTION_TOGGLE_STATS_RECORDING, INPUT_KEY, KEY_F7, KEY_NULL },
+    { ACTION_TOGGLE_TRACE_CAPTURE, INPUT_KEY, KEY_F8, KEY_NULL },
+    { ACTION_TOGGLE_LATENCY_PROBE, INPUT_KEY, KEY_F9, KEY_NULL },
+};
+
+static InputBinding bindings[INPUT_MAX_BINDINGS];
+static int bindingCount = 0;
+
+void Input_ResetBindings(void) {
+    bindingCount = (int)(sizeof(defaultBindings) / sizeof(defaultBindings[0]));
+    for (int i = 0; i < bindingCount; i++) {
+        bindings[i] = defaultBindings[i];
+    }
+}
+
+void Input_ClearBindings(InputAction action) {
+    int kept = 0;
+    for (int i = 0; i < bindingCount; i++) {
+        if (bindings[i].action != action) bindings[kept++] = bindings[i];
+    }
+    bindingCount = kept;
+}
+
+bool Input_AddBinding(InputBinding binding) {
+    if (binding.action < 0 || binding.action >= ACTION_COUNT || bindingCount >= INPUT_MAX_BINDINGS) {
+        return false;
+    }
+    bindings[bindingCount++] = binding;
+    return true;
+}
+
+void Input_SetSource(EngineState* engine, const InputFrame* frame) {
+    if (engine) engine->inputSource = frame;
+}
+
+// Mouse position on the UI canvas
+static Vector2 Input_GetCanvasMousePosition(EngineState* engine, Vector2 rawMousePos) {
     // Scale mouse position if using internal resolution
     if (engine->useInternalResolution) {
         if (engine->maintainAspectRatio) {
             // Convert from screen space to render texture space with aspect ratio letterboxing
             float scaleX = (float)engine->internalWidth / engine->destRect.width;
             float scaleY = (float)engine->internalHeight / engine->destRect.height;
-            
+
             rawMousePos.x = (rawMousePos.x - engine->destRect.x) * scaleX;
             rawMousePos.y = (rawMousePos.y - engine->destRect.y) * scaleY;
         } else {
             // Convert from screen space to render texture space (stretched full screen)
             float scaleX = (float)engine->internalWidth / (float)engine->windowWidth;
             float scaleY = (float)engine->internalHeight / (float)engine->windowHeight;
-            
+
             rawMousePos.x = rawMousePos.x * scaleX;
             rawMousePos.y = rawMousePos.y * scaleY;
         }
-        
+
         // Clamp to internal resolution bounds
         if (rawMousePos.x < 0) rawMousePos.x = 0;
         if (rawMousePos.x > engine->internalWidth) rawMousePos.x = engine->internalWidth;
         if (rawMousePos.y < 0) rawMousePos.y = 0;
         if (rawMousePos.y > engine->internalHeight) rawMousePos.y = engine->internalHeight;
     }
-    
-    engine->mousePosition = rawMousePos;
-    engine->mouseDelta = GetMouseDelta();
-    engine->mouseWheel = GetMouseWheelMove();
-    
-    engine->mouseLeftPressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
-    engine->mouseRightPressed = IsMouseButtonPressed(MOUSE_RIGHT_BUTTON);
-    engine->mouseMiddlePressed = IsMouseButtonPressed(MOUSE_MIDDLE_BUTTON);
-    
-    // Update gamepad state
-    Input_UpdateGamepads(engine);
-    
-    // Handle common input actions (keyboard or gamepad)
-    bool tabPressed = IsKeyPressed(KEY_TAB);
+
+    return rawMousePos;
+}
+
+// True when a key or button went down or up since the last poll
+static bool Input_ScanActivity(EngineState* engine) {
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++) {
+        if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button)) return true;
+    }
+
+    // Scan the key state instead of GetKeyPressed() to leave the key queue intact
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU; key++) {
+        if (IsKeyPressed(key) || IsKeyReleased(key)) return true;
+    }
+
+    // Gamepads don't wake the event loop, so they're polled here as well
     if (engine->activeGamepad >= 0) {
-        tabPressed = tabPressed || IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_UP);
+        for (int button = GAMEPAD_BUTTON_LEFT_FACE_UP; button <= GAMEPAD_BUTTON_RIGHT_THUMB; button++) {
+            if (IsGamepadButtonPressed(engine->activeGamepad, button) ||
+                IsGamepadButtonReleased(engine->activeGamepad, button)) {
+                return true;
+            }
+        }
     }
-    
-    if (tabPressed) {
-        ViewMode newMode = engine->viewMode;
-        switch (engine->viewMode) {
-            case VIEW_MODE_ORBIT:
-                newMode = VIEW_MODE_ISOMETRIC;
+
+    return false;
+}
+
+// Action changes seen by the samples since the last frame. raylib only
+// reports device state at each poll, so a change is stamped halfway between
+// the poll that saw it and the one before.
+typedef struct {
+    long long timeNs;
+    InputAction action;
+    float value;
+} InputEvent;
+
+static InputEvent events[INPUT_EVENT_QUEUE_SIZE];
+static int eventCount = 0;
+
+// Device state as of the latest sample
+static float sampleValue[ACTION_COUNT];
+static float sampleAxes[GAMEPAD_AXIS_COUNT];
+static float sampleWheel = 0.0f;       // Summed over the samples, raylib resets it on each poll
+static bool sampleActivity = false;
+static long long sampleTimeNs = 0;
+static long long frameTimeNs = 0;      // When the last frame was built
+static Vector2 lastMouseScreenPosition = { 0 };
+static long long probePressNs = 0;     // First TURN_LEFT press among the frame's samples, 0 for none
+
+// Evaluate the binding table against the devices; each action takes the strongest of its bindings
+static void Input_ReadActions(EngineState* engine, float* values) {
+    int gamepad = engine->activeGamepad;
+    if (gamepad >= 0) {
+        for (int axis = 0; axis < GAMEPAD_AXIS_COUNT; axis++) {
+            float value = GetGamepadAxisMovement(gamepad, axis);
+
+            if (axis == GAMEPAD_AXIS_LEFT_TRIGGER || axis == GAMEPAD_AXIS_RIGHT_TRIGGER) {
+                // Normalize trigger value (some controllers report -1 to 1, others 0 to 1)
+                value = (value + 1.0f) * 0.5f;
+                if (value < GAMEPAD_TRIGGER_THRESHOLD) value = 0;
+            } else if (fabsf(value) < GAMEPAD_DEAD_ZONE) {
+                value = 0;
+            }
+            sampleAxes[axis] = value;
+        }
+    } else {
+        for (int axis = 0; axis < GAMEPAD_AXIS_COUNT; axis++) sampleAxes[axis] = 0.0f;
+    }
+
+    for (int action = 0; action < ACTION_COUNT; action++) values[action] = 0.0f;
+
+    for (int i = 0; i < bindingCount; i++) {
+        const InputBinding* binding = &bindings[i];
+        float value = 0.0f;
+
+        if (binding->modifier != KEY_NULL && !IsKeyDown(binding->modifier)) continue;
+
+        switch (binding->source) {
+            case INPUT_KEY:
+                value = IsKeyDown(binding->code) ? 1.0f : 0.0f;
                 break;
-            case VIEW_MODE_ISOMETRIC:
-                newMode = VIEW_MODE_ORBIT;
+            case INPUT_MOUSE_BUTTON:
+                value = IsMouseButtonDown(binding->code) ? 1.0f : 0.0f;
                 break;
-            default:
+            case INPUT_GAMEPAD_BUTTON:
+                if (gamepad >= 0) value = IsGamepadButtonDown(gamepad, binding->code) ? 1.0f : 0.0f;
+                break;
+            case INPUT_GAMEPAD_AXIS_POSITIVE:
+                if (binding->code >= 0 && binding->code < GAMEPAD_AXIS_COUNT) value = sampleAxes[binding->code];
+                break;
+            case INPUT_GAMEPAD_AXIS_NEGATIVE:
+                if (binding->code >= 0 && binding->code < GAMEPAD_AXIS_COUNT) value = -sampleAxes[binding->code];
                 break;
         }
-        Camera_SetMode(engine, newMode);
-    }
-    
-    // Toggle display options (keyboard or gamepad)
-    if (IsKeyPressed(KEY_I) || 
-        (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_MIDDLE_LEFT))) {
-        engine->showDebugInfo = !engine->showDebugInfo;
-    }
-    if (IsKeyPressed(KEY_U) || 
-        (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_MIDDLE_RIGHT))) {
-        engine->showUI = !engine->showUI;
+
+        if (value > values[binding->action]) values[binding->action] = value;
     }
 }
 
-// Wrapper functions for consistency
-bool Input_IsKeyPressed(int key) { return IsKeyPressed(key); }
-bool Input_IsKeyDown(int key) { return IsKeyDown(key); }
-bool Input_IsKeyReleased(int key) { return IsKeyReleased(key); }
-bool Input_IsMouseButtonPressed(int button) { return IsMouseButtonPressed(button); }
-bool Input_IsMouseButtonDown(int button) { return IsMouseButtonDown(button); }
-bool Input_IsMouseButtonReleased(int button) { return IsMouseButtonReleased(button); }
-Vector2 Input_GetMousePosition(void) { return GetMousePosition(); }
-Vector2 Input_GetMouseDelta(void) { return GetMouseDelta(); }
-float Input_GetMouseWheel(void) { return GetMouseWheelMove(); }
-
-// Gamepad input functions
-bool Input_IsGamepadAvailable(int gamepad) {
-    return IsGamepadAvailable(gamepad);
-}
+// Read the devices as of raylib's last poll and queue what changed
+static void Input_Record(EngineState* engine) {
+    float values[ACTION_COUNT];
+    Input_ReadActions(engine, values);
 
-bool Input_IsGamepadButtonPressed(int gamepad, int button) {
-    return IsGamepadAvailable(gamepad) && IsGamepadButtonPressed(gamepad, button);
-}
+    long long now = Utils_GetTimeNs();
+    long long stamp = (sampleTimeNs > 0) ? sampleTimeNs + (now - sampleTimeNs) / 2 : now;
+
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        if (values[action] == sampleValue[action]) continue;
+
+        // A full queue drops the change's timing; it still lands at the end of the frame
+        if (eventCount < INPUT_EVENT_QUEUE_SIZE) {
+            events[eventCount++] = (InputEvent){ stamp, (InputAction)action, values[action] };
+        }
+        sampleValue[action] = values[action];
+    }
 
-bool Input_IsGamepadButtonDown(int gamepad, int button) {
-    return IsGamepadAvailable(gamepad) && IsGamepadButtonDown(gamepad, button);
+    sampleWheel += GetMouseWheelMove();
+
+    // Each poll resets raylib's resize flag, so keep it until the frame is built.
+    // The device scan only matters for idle rendering and is skipped otherwise.
+    sampleActivity = sampleActivity || IsWindowResized();
+    if (engine->idle && !sampleActivity) sampleActivity = Input_ScanActivity(engine);
+    sampleTimeNs = now;
 }
 
-bool Input_IsGamepadButtonReleased(int gamepad, int button) {
-    return IsGamepadAvailable(gamepad) && IsGamepadButtonReleased(gamepad, button);
+void Input_Sample(EngineState* engine) {
+    if (!engine || engine->inputSource) return;
+
+    PollInputEvents();
+    Input_Record(engine);
 }
 
-Vector2 Input_GetGamepadLeftStick(int gamepad) {
-    if (!IsGamepadAvailable(gamepad)) return (Vector2){0, 0};
-    
-    float x = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_X);
-    float y = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_Y);
-    
-    // Apply dead zone
-    if (fabsf(x) < GAMEPAD_DEAD_ZONE) x = 0;
-    if (fabsf(y) < GAMEPAD_DEAD_ZONE) y = 0;
-    
-    return (Vector2){x, y};
+// Average each action's value over [startNs, endNs] from the queued changes
+static void Input_IntegrateHeld(const float* startValue, long long startNs, long long endNs, float* held) {
+    if (startNs <= 0 || endNs <= startNs) {
+        for (int action = 0; action < ACTION_COUNT; action++) held[action] = sampleValue[action];
+        return;
+    }
+
+    float value[ACTION_COUNT];
+    long long fromNs[ACTION_COUNT];
+    double sum[ACTION_COUNT];
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        value[action] = startValue[action];
+        fromNs[action] = startNs;
+        sum[action] = 0.0;
+    }
+
+    for (int i = 0; i < eventCount; i++) {
+        const InputEvent* event = &events[i];
+        long long t = event->timeNs;
+        if (t < startNs) t = startNs;
+        if (t > endNs) t = endNs;
+
+        sum[event->action] += value[event->action] * (double)(t - fromNs[event->action]);
+        value[event->action] = event->value;
+        fromNs[event->action] = t;
+    }
+
+    double span = (double)(endNs - startNs);
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        sum[action] += value[action] * (double)(endNs - fromNs[action]);
+        held[action] = (float)(sum[action] / span);
+    }
 }
 
-Vector2 Input_GetGamepadRightStick(int gamepad) {
-    if (!IsGamepadAvailable(gamepad)) return (Vector2){0, 0};
-    
-    float x = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_RIGHT_X);
-    float y = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_RIGHT_Y);
-    
-    // Apply dead zone
-    if (fabsf(x) < GAMEPAD_DEAD_ZONE) x = 0;
-    if (fabsf(y) < GAMEPAD_DEAD_ZONE) y = 0;
-    
-    return (Vector2){x, y};
+// Timestamp of the first queued change that takes an action from up to down
+static long long Input_FirstPressNs(InputAction action, float startValue) {
+    float value = startValue;
+    for (int i = 0; i < eventCount; i++) {
+        if (events[i].action != action) continue;
+        if (value <= 0.0f && events[i].value > 0.0f) return events[i].timeNs;
+        value = events[i].value;
+    }
+    return 0;
 }
 
-float Input_GetGamepadLeftTrigger(int gamepad) {
-    if (!IsGamepadAvailable(gamepad)) return 0;
-    
-    float trigger = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_LEFT_TRIGGER);
-    
-    // Normalize trigger value (some controllers report -1 to 1, others 0 to 1)
-    trigger = (trigger + 1.0f) * 0.5f;
-    
-    // Apply threshold
-    if (trigger < GAMEPAD_TRIGGER_THRESHOLD) trigger = 0;
-    
-    return trigger;
+// Build the frame from the samples taken since the last one plus raylib's latest poll
+static void Input_PollDevices(EngineState* engine, InputFrame* frame) {
+    Input_UpdateGamepads(engine);
+    Input_Record(engine);
+
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        frame->value[action] = sampleValue[action];
+        frame->down[action] = sampleValue[action] > 0.0f;
+    }
+    for (int axis = 0; axis < GAMEPAD_AXIS_COUNT; axis++) {
+        frame->gamepadAxes[axis] = sampleAxes[axis];
+    }
+    // Mid-frame polls reset raylib's own delta, so it's taken between frames here
+    frame->mouseScreenPosition = GetMousePosition();
+    frame->mousePosition = Input_GetCanvasMousePosition(engine, frame->mouseScreenPosition);
+    if (frameTimeNs > 0) {
+        frame->mouseDelta = Vector2Subtract(frame->mouseScreenPosition, lastMouseScreenPosition);
+    }
+    lastMouseScreenPosition = frame->mouseScreenPosition;
+
+    Input_IntegrateHeld(engine->input.value, frameTimeNs, sampleTimeNs, frame->held);
+    probePressNs = Input_FirstPressNs(ACTION_TURN_LEFT, engine->input.value[ACTION_TURN_LEFT]);
+    frameTimeNs = sampleTimeNs;
+    eventCount = 0;
+
+    frame->mouseWheel = sampleWheel;
+    sampleWheel = 0.0f;
+
+    frame->activity = sampleActivity || frame->mouseWheel != 0.0f ||
+                      frame->mouseDelta.x != 0.0f || frame->mouseDelta.y != 0.0f;
+    sampleActivity = false;
+    for (int axis = 0; axis < GAMEPAD_AXIS_COUNT && !frame->activity; axis++) {
+        frame->activity = frame->gamepadAxes[axis] != 0.0f;
+    }
 }
 
-float Input_GetGamepadRightTrigger(int gamepad) {
-    if (!IsGamepadAvailable(gamepad)) return 0;
-    
-    float trigger = GetGamepadAxisMovement(gamepad, GAMEPAD_AXIS_RIGHT_TRIGGER);
-    
-    // Normalize trigger value (some controllers report -1 to 1, others 0 to 1)
-    trigger = (trigger + 1.0f) * 0.5f;
-    
-    // Apply threshold
-    if (trigger < GAMEPAD_TRIGGER_THRESHOLD) trigger = 0;
-    
-    return trigger;
+void Input_Update(EngineState* engine) {
+    if (!engine) return;
+
+    InputFrame frame = { 0 };
+    if (engine->inputSource) {
+        // Replays and bots supply held state; edges are derived below as for devices.
+        // Sources that leave the sub-frame average at zero hold their value all frame.
+        const InputFrame* source = engine->inputSource;
+        frame = *source;
+        for (int action = 0; action < ACTION_COUNT; action++) {
+            frame.down[action] = source->value[action] > 0.0f;
+            if (frame.held[action] == 0.0f) frame.held[action] = source->value[action];
+        }
+        eventCount = 0;
+        frameTimeNs = 0;
+        probePressNs = 0;
+    } else {
+        Input_PollDevices(engine, &frame);
+    }
+
+    for (int action = 0; action < ACTION_COUNT; action++) {
+        frame.pressed[action] = frame.down[action] && !engine->input.down[action];
+        frame.released[action] = !frame.down[action] && engine->input.down[action];
+    }
+    engine->input = frame;
+
+    const InputFrame* input = &engine->input;
+
+    // Starts an input-to-present probe when measuring latency, from when the
+    // press was sampled so waits in the swap before this update are counted
+    if (input->pressed[ACTION_TURN_LEFT]) {
+        Telemetry_StartLatency(engine, probePressNs > 0 ? probePressNs : Utils_GetTimeNs());
+    }
+
+    if (input->pressed[ACTION_CAMERA_MODE]) {
+        ViewMode newMode = engine->viewMode;
+        switch (engine->viewMode) {
+            case VIEW_MODE_ORBIT:
+                newMode = VIEW_MODE_ISOMETRIC;
+                break;
+            case VIEW_MODE_ISOMETRIC:
+                newMode = VIEW_MODE_ORBIT;
+                break;
+            default:
+                break;
+        }
+        Camera_SetMode(engine, newMode);
+    }
+
+    // Toggle display options
+    if (input->pressed[ACTION_TOGGLE_DEBUG_INFO]) {
+        engine->showDebugInfo = !engine->showDebugInfo;
+    }
+    if (input->pressed[ACTION_TOGGLE_UI]) {
+        engine->showUI = !engine->showUI;
+    }
 }
 
 int Input_GetActiveGamepad(EngineState* engine) {
@@ -167,26 +421,20 @@ int Input_GetActiveGamepad(EngineState* engine) {
 
 void Input_UpdateGamepads(EngineState* engine) {
     if (!engine) return;
-    
+
     // Find first connected gamepad or detect new connections
     engine->activeGamepad = -1;
-    
+
     for (int i = 0; i < MAX_GAMEPADS; i++) {
         bool wasConnected = engine->gamepadConnected[i];
         engine->gamepadConnected[i] = IsGamepadAvailable(i);
-        
+
         if (engine->gamepadConnected[i]) {
             // Set first available gamepad as active
             if (engine->activeGamepad < 0) {
                 engine->activeGamepad = i;
             }
-            
-            // Update stick positions for all connected gamepads
-            engine->gamepadLeftStick[i] = Input_GetGamepadLeftStick(i);
-            engine->gamepadRightStick[i] = Input_GetGamepadRightStick(i);
-            engine->gamepadLeftTrigger[i] = Input_GetGamepadLeftTrigger(i);
-            engine->gamepadRightTrigger[i] = Input_GetGamepadRightTrigger(i);
-            
+
             // Log new connections
             if (!wasConnected) {
                 TraceLog(LOG_INFO, "Gamepad %d connected: %s", i, GetGamepadName(i));
@@ -194,12 +442,6 @@ void Input_UpdateGamepads(EngineState* engine) {
         } else if (wasConnected) {
             // Log disconnections
             TraceLog(LOG_INFO, "Gamepad %d disconnected", i);
-            
-            // Clear state for disconnected gamepad
-            engine->gamepadLeftStick[i] = (Vector2){0, 0};
-            engine->gamepadRightStick[i] = (Vector2){0, 0};
-            engine->gamepadLeftTrigger[i] = 0;
-            engine->gamepadRightTrigger[i] = 0;
         }
     }
-}
\ No newline at end of file
+}
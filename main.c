@@ -15,7 +15,9 @@
 // Game settings
 #define ARENA_SIZE 100.0f
 #define INITIAL_SEGMENTS 5
-#define MAX_SEGMENTS 500
+#ifndef MAX_SEGMENTS
+#define MAX_SEGMENTS 500  // Benchmarks override this to test longer riders
+#endif
 #define SEGMENT_SIZE 0.8f
 #define SEGMENT_SPACING 1.0f
 #define LINE_RIDER_SPEED 12.0f
@@ -24,6 +26,10 @@
 #define MAX_ENERGY 100.0f
 #define ENERGY_BAR_VALUE 20.0f
 #define POWERUP_LIFETIME 30.0f
+#ifndef MAX_POWERUPS
+#define MAX_POWERUPS 4096  // Pool capacity; the --stress powerups scene fills it
+#endif
+#define POWERUP_LIMIT 20   // Active powerups allowed in normal play
 
 // Visual settings
 #define TRAIL_GLOW_SIZE 1.2f
@@ -34,6 +40,10 @@
 #define STAR_COUNT 200
 #define HARDCORE_SPEED_MULTI 2.0f
 
+// Music settings
+#define MUSIC_BASE_TEMPO 112.0f  // Beats per minute at normal difficulty and full time
+#define MUSIC_VOLUME 0.6f
+
 // Powerup types
 typedef enum {
     POWERUP_ENERGY,
@@ -122,9 +132,57 @@ typedef enum {
     SFX_COUNT
 } SoundEffect;
 
+// Synthesis parameters for every effect; rendered once and kept in the sound bank cache
+static const SynthParams soundEffectParams[SFX_COUNT] = {
+    //                    waveform             freq     end    dur    A       D      S     R      fm   index  vol
+    [SFX_PICKUP_ENERGY] = { SYNTH_WAVE_TRIANGLE,  600.0f, 1200.0f, 0.15f, 0.005f, 0.05f, 0.6f, 0.06f, 0.0f, 0.0f, 0.9f },
+    [SFX_PICKUP_BOOST]  = { SYNTH_WAVE_SAW,       300.0f, 1400.0f, 0.25f, 0.01f,  0.1f,  0.5f, 0.1f,  2.0f, 1.5f, 0.7f },
+    [SFX_PICKUP_SLOW]   = { SYNTH_WAVE_SINE,      900.0f,  300.0f, 0.35f, 0.01f,  0.1f,  0.6f, 0.15f, 0.5f, 2.0f, 0.8f },
+    [SFX_PICKUP_SHIELD] = { SYNTH_WAVE_SINE,      600.0f,  600.0f, 0.3f,  0.02f,  0.1f,  0.7f, 0.12f, 3.0f, 2.5f, 0.8f },
+    [SFX_PICKUP_SHRINK] = { SYNTH_WAVE_SQUARE,   1000.0f,  400.0f, 0.15f, 0.005f, 0.05f, 0.5f, 0.05f, 0.0f, 0.0f, 0.5f },
+    [SFX_PICKUP_BONUS]  = { SYNTH_WAVE_TRIANGLE, 1000.0f, 1600.0f, 0.25f, 0.005f, 0.05f, 0.7f, 0.1f,  2.0f, 1.0f, 0.9f },
+    [SFX_TURN]          = { SYNTH_WAVE_SQUARE,    300.0f,  280.0f, 0.05f, 0.002f, 0.02f, 0.5f, 0.02f, 0.0f, 0.0f, 0.3f },
+    [SFX_LOOP_COMPLETE] = { SYNTH_WAVE_TRIANGLE,  800.0f, 1600.0f, 0.4f,  0.01f,  0.1f,  0.8f, 0.15f, 1.5f, 1.0f, 1.0f },
+    [SFX_COLLISION]     = { SYNTH_WAVE_NOISE,       0.0f,    0.0f, 0.3f,  0.002f, 0.1f,  0.3f, 0.15f, 0.0f, 0.0f, 0.9f },
+    [SFX_GAME_OVER]     = { SYNTH_WAVE_SAW,       400.0f,   80.0f, 0.8f,  0.01f,  0.2f,  0.6f, 0.3f,  0.5f, 3.0f, 0.9f },
+    [SFX_MENU_SELECT]   = { SYNTH_WAVE_SQUARE,    700.0f,  900.0f, 0.1f,  0.002f, 0.03f, 0.6f, 0.04f, 0.0f, 0.0f, 0.5f },
+    [SFX_MENU_MOVE]     = { SYNTH_WAVE_SQUARE,    500.0f,  500.0f, 0.05f, 0.002f, 0.02f, 0.5f, 0.02f, 0.0f, 0.0f, 0.4f },
+    [SFX_PAUSE]         = { SYNTH_WAVE_TRIANGLE,  500.0f,  350.0f, 0.15f, 0.005f, 0.05f, 0.6f, 0.06f, 0.0f, 0.0f, 0.7f },
+    [SFX_WARNING]       = { SYNTH_WAVE_SQUARE,    440.0f,  440.0f, 0.2f,  0.005f, 0.05f, 0.8f, 0.05f, 0.0f, 0.0f, 0.5f },
+};
+
+// Overlap rules per effect: frequent, quiet effects get low priority so they
+// never cut off game over or collision sounds
+static const AudioSoundSettings soundEffectMixing[SFX_COUNT] = {
+    //                    volume  voices  priority  retrigger
+    [SFX_PICKUP_ENERGY] = { 1.0f, 4, 2, 0.03f },
+    [SFX_PICKUP_BOOST]  = { 1.0f, 2, 2, 0.05f },
+    [SFX_PICKUP_SLOW]   = { 1.0f, 2, 2, 0.05f },
+    [SFX_PICKUP_SHIELD] = { 1.0f, 2, 2, 0.05f },
+    [SFX_PICKUP_SHRINK] = { 1.0f, 2, 2, 0.05f },
+    [SFX_PICKUP_BONUS]  = { 1.0f, 4, 2, 0.03f },
+    [SFX_TURN]          = { 1.0f, 3, 0, 0.1f },
+    [SFX_LOOP_COMPLETE] = { 1.0f, 2, 3, 0.1f },
+    [SFX_COLLISION]     = { 1.0f, 1, 4, 0.1f },
+    [SFX_GAME_OVER]     = { 1.0f, 1, 5, 0.5f },
+    [SFX_MENU_SELECT]   = { 1.0f, 2, 3, 0.03f },
+    [SFX_MENU_MOVE]     = { 1.0f, 2, 1, 0.03f },
+    [SFX_PAUSE]         = { 1.0f, 1, 3, 0.1f },
+    [SFX_WARNING]       = { 1.0f, 1, 3, 0.5f },
+};
+
+// Mixer sound IDs, filled in by the audio init worker
+typedef struct {
+    int sounds[SFX_COUNT];
+    const char* wavPath;  // Record the mix here instead of using the sound device
+    int ready;            // Published with release ordering once the mixer is running
+    UtilsThread* worker;
+} GameAudio;
+
 typedef struct {
     LineRider rider;
-    Powerup powerups[20];
+    Powerup powerups[MAX_POWERUPS];
+    int powerupLimit;     // Slots SpawnPowerup may use (POWERUP_LIMIT in normal play)
     Particle particles[PARTICLE_COUNT];
     Star stars[STAR_COUNT];
     float gameTime;
@@ -143,16 +201,8 @@ typedef struct {
     int highScoreHardcore;
 
     // Sound effects
-    Sound soundPickup;
-    Sound soundTurn;
-    Sound soundGameOver;
-    Sound soundBoost;
-    Sound soundShield;
-    Sound soundMenuSelect;
-    Sound soundPause;
-    Sound soundLoopComplete;
+    GameAudio* audio;
     bool soundEnabled;
-    bool useFallbackAudio;
     float masterVolume;
     bool showFPS;
 } GameState;
@@ -161,304 +211,123 @@ typedef struct {
 // Sound Generation Functions
 // =====================================
 
-// Fallback audio using system beep
-void PlayFallbackBeep(int frequency, int duration) {
-    #ifdef __linux__
-    // Use beep command if available, or echo to PC speaker
-    char cmd[256];
-    snprintf(cmd, sizeof(cmd), "( speaker-test -t sine -f %d -l 1 & pid=$!; sleep 0.%03d; kill -9 $pid ) >/dev/null 2>&1 &",
-             frequency, duration);
-    system(cmd);
-    #else
-    // For non-Linux, just print that sound would play
-    printf("[Sound: %dHz for %dms]\n", frequency, duration);
-    #endif
+// Audio the game thread may use right now; requests made while the
+// mixer is still starting up are dropped
+GameAudio* GetReadyAudio(GameState* game) {
+    if (!game->soundEnabled || !game->audio) return NULL;
+    if (!__atomic_load_n(&game->audio->ready, __ATOMIC_ACQUIRE)) return NULL;
+    return game->audio;
 }
 
-void PlayFallbackSound(GameState* game, Sound* sound) {
-    if (!game->soundEnabled) return;
-
-    // Map different sounds to different beep patterns
-    if (sound == &game->soundPickup) {
-        PlayFallbackBeep(800, 100);
-    } else if (sound == &game->soundTurn) {
-        PlayFallbackBeep(300, 30);
-    } else if (sound == &game->soundGameOver) {
-        PlayFallbackBeep(200, 500);
-    } else if (sound == &game->soundBoost) {
-        PlayFallbackBeep(1000, 150);
-    } else if (sound == &game->soundShield) {
-        PlayFallbackBeep(600, 200);
-    } else if (sound == &game->soundMenuSelect) {
-        PlayFallbackBeep(700, 80);
-    } else if (sound == &game->soundPause) {
-        PlayFallbackBeep(400, 100);
-    } else if (sound == &game->soundLoopComplete) {
-        PlayFallbackBeep(1200, 250);
-    }
+void PlaySoundEffect(GameState* game, SoundEffect effect) {
+    GameAudio* audio = GetReadyAudio(game);
+    if (audio) Audio_Play(audio->sounds[effect], 1.0f);
 }
 
-void PlayGameSound(GameState* game, Sound sound) {
-    if (!game->soundEnabled) {
-        return;
-    }
-
-    // If using fallback audio, we can't play the actual sound
-    // For now, just skip it - the caller should use specific functions
-    if (game->useFallbackAudio) {
-        // Fallback audio needs specific handling per sound type
-        // This is handled in the specific play functions below
-        return;
-    }
-
-    // Play the actual raylib sound
-    PlaySound(sound);
+// Effect heard from a point in the arena; the mixer attenuates and pans it
+void PlaySoundEffectAt(GameState* game, SoundEffect effect, Vector3 position) {
+    GameAudio* audio = GetReadyAudio(game);
+    if (audio) Audio_PlayAt(audio->sounds[effect], 1.0f, position);
 }
 
-// Helper functions for playing specific sounds
-void PlayPickupSound(GameState* game) {
-    if (!game->soundEnabled) return;
-
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(800, 100);
-    } else {
-        PlaySound(game->soundPickup);
-    }
-}
-
-void PlayBoostSound(GameState* game) {
-    if (!game->soundEnabled) return;
-
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(1000, 150);
-    } else {
-        PlaySound(game->soundBoost);
-    }
-}
-
-void PlayShieldSound(GameState* game) {
-    if (!game->soundEnabled) return;
-
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(600, 200);
-    } else {
-        PlaySound(game->soundShield);
-    }
+// Hand the mixer this frame's camera; spatialization itself runs on the audio thread
+void UpdateSoundListener(GameState* game, EngineState* engine) {
+    if (GetReadyAudio(game)) Audio_SetListener(&engine->camera);
 }
 
-void PlayMenuSound(GameState* game) {
-    if (!game->soundEnabled) return;
+// Music follows the run: faster on hardcore, slower while slow time lasts and
+// busier as energy runs out. Only the targets are set here; the sequencer and
+// synthesis run inside the mixer.
+void UpdateMusic(GameState* game) {
+    if (!game->audio || !__atomic_load_n(&game->audio->ready, __ATOMIC_ACQUIRE)) return;
+
+    float danger = 1.0f - game->rider.energy / MAX_ENERGY;
+    float difficulty = (game->difficultyMultiplier - 1.0f) / (HARDCORE_SPEED_MULTI - 1.0f);
+    MusicState state = {
+        MUSIC_BASE_TEMPO * (1.0f + 0.25f * difficulty) * (0.5f + 0.5f * game->slowTimeMultiplier),
+        Clamp(0.3f + 0.3f * difficulty + 0.6f * danger, 0.0f, 1.0f),
+        MUSIC_VOLUME
+    };
 
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(700, 80);
-    } else {
-        PlaySound(game->soundMenuSelect);
-    }
+    if (game->inMenu) {
+        state.tempo = MUSIC_BASE_TEMPO;
+        state.intensity = 0.0f;
+    }
+    if (!game->soundEnabled || game->gameOver) state.volume = 0.0f;
+    if (game->paused) state.volume *= 0.3f;
+    Music_SetState(&state);
+
+#ifdef PROFILER_ENABLED
+    AudioStats stats;
+    Audio_GetStats(&stats);
+    PROFILE_COUNTER("audio_mix_ms", stats.mixMs);
+    PROFILE_COUNTER("music_ms", stats.callbackMs);
+    PROFILE_COUNTER("audio_load_pct", stats.peakLoad * 100.0);
+#endif
 }
 
-void PlayTurnSound(GameState* game) {
-    if (!game->soundEnabled) return;
-
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(300, 30);
-    } else {
-        PlaySound(game->soundTurn);
+// Runs on the audio worker: device bring-up can block for a long time on
+// some sound servers, so the menu is shown while this is still going
+void InitSoundsWorker(void* arg) {
+    GameAudio* audio = (GameAudio*)arg;
+    long long startNs = Utils_GetTimeNs();
+    PROFILE_BEGIN("InitSoundsWorker");
+
+    // Effects come from the on-disk bank; only a cache miss synthesizes them
+    if (!Synth_LoadBank(soundEffectParams, SFX_COUNT, SYNTH_BANK_PATH)) {
+        TraceLog(LOG_WARNING, "Audio: sound bank unavailable, sound is disabled");
+        PROFILE_END();
+        return;
     }
-}
-
-void PlayGameOverSound(GameState* game) {
-    if (!game->soundEnabled) return;
-
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(200, 500);
-    } else {
-        PlaySound(game->soundGameOver);
+    for (int i = 0; i < SFX_COUNT; i++) {
+        int frameCount = 0;
+        const short* samples = Synth_GetBankSamples(i, &frameCount);
+        audio->sounds[i] = Audio_AddSound(samples, frameCount, &soundEffectMixing[i]);
     }
-}
+    Audio_SetMixCallback(Music_Render);
+    long long soundsNs = Utils_GetTimeNs();
 
-void PlayPauseSound(GameState* game) {
-    if (!game->soundEnabled) return;
-
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(400, 100);
-    } else {
-        PlaySound(game->soundPause);
+    // Without a device the mixer still runs, into a WAV file or nowhere
+    if (!Audio_Start(audio->wavPath ? AUDIO_SINK_WAV : AUDIO_SINK_STREAM, audio->wavPath)) {
+        TraceLog(LOG_WARNING, "Audio: mixer did not start, sound is disabled");
+        PROFILE_END();
+        return;
     }
-}
-
-void PlayLoopCompleteSound(GameState* game) {
-    if (!game->soundEnabled) return;
 
-    if (game->useFallbackAudio) {
-        PlayFallbackBeep(1200, 250);
-    } else {
-        PlaySound(game->soundLoopComplete);
-    }
+    TraceLog(LOG_INFO, "Audio ready: sounds %.1fms, device %.1fms",
+             (soundsNs - startNs) / 1000000.0, (Utils_GetTimeNs() - soundsNs) / 1000000.0);
+    __atomic_store_n(&audio->ready, 1, __ATOMIC_RELEASE);
+    PROFILE_END();
 }
 
-Sound GenerateBeepSound(float frequency, float duration, int sampleRate) {
-    int frames = (int)(duration * sampleRate);
-    short* data = (short*)calloc(frames, sizeof(short));
-
-    if (!data) {
-        printf("ERROR: Failed to allocate memory for sound\n");
-        return (Sound){0};
-    }
-
-    for (int i = 0; i < frames; i++) {
-        float t = (float)i / sampleRate;
-        float sample = sinf(2.0f * PI * frequency * t);
-
-        // Simple envelope
-        float envelope = 1.0f;
-        if (i < frames / 10) {
-            envelope = (float)i / (frames / 10);
-        } else if (i > frames * 9 / 10) {
-            envelope = (float)(frames - i) / (frames / 10);
-        }
-
-        // Increase amplitude
-        data[i] = (short)(sample * envelope * 30000.0f);
-    }
-
-    Wave wave = {0};
-    wave.frameCount = frames;
-    wave.sampleRate = sampleRate;
-    wave.sampleSize = 16;
-    wave.channels = 1;
-    wave.data = data;
-
-    printf("Generated beep: freq=%.1fHz, duration=%.2fs, frames=%d\n", frequency, duration, frames);
+// wavPath records the mix to a file instead of playing it
+void InitSounds(GameState* game, const char* wavPath) {
+    game->soundEnabled = true;
+    game->masterVolume = 1.0f;  // Maximum volume
 
-    Sound sound = LoadSoundFromWave(wave);
-    free(data);  // Free data after loading sound
+    game->audio = (GameAudio*)calloc(1, sizeof(GameAudio));
+    if (!game->audio) return;
+    game->audio->wavPath = wavPath;
 
-    if (sound.frameCount == 0) {
-        printf("ERROR: Failed to load sound from wave\n");
+    // Fall back to initializing on the game thread if no worker can be started
+    game->audio->worker = Utils_StartThread(InitSoundsWorker, game->audio);
+    if (!game->audio->worker) {
+        InitSoundsWorker(game->audio);
     }
-
-    return sound;
-}
-
-Sound GeneratePickupSound() {
-    // Simple rising tone - use basic beep for now
-    return GenerateBeepSound(800.0f, 0.15f, 22050);
-}
-
-Sound GenerateGameOverSound() {
-    // Simple descending tone - use low beep for now
-    return GenerateBeepSound(200.0f, 0.5f, 22050);
+    Telemetry_MarkStartup("audio worker start");
 }
 
-void InitSounds(GameState* game) {
-    printf("\n=== AUDIO INITIALIZATION ===\n");
-    printf("Initializing audio device...\n");
-
-    // Try to initialize audio device
-    InitAudioDevice();
-
-    // Check if audio device is ready
-    if (!IsAudioDeviceReady()) {
-        printf("WARNING: Raylib audio not available!\n");
-        printf("Using fallback system beeps instead.\n");
-        game->soundEnabled = true;
-        game->useFallbackAudio = true;
-
-        // Initialize dummy sound structures so the game doesn't crash
-        game->soundPickup = (Sound){0};
-        game->soundPickup.frameCount = 1;
-        game->soundTurn = (Sound){0};
-        game->soundTurn.frameCount = 2;
-        game->soundGameOver = (Sound){0};
-        game->soundGameOver.frameCount = 3;
-        game->soundBoost = (Sound){0};
-        game->soundBoost.frameCount = 4;
-        game->soundShield = (Sound){0};
-        game->soundShield.frameCount = 5;
-        game->soundMenuSelect = (Sound){0};
-        game->soundMenuSelect.frameCount = 6;
-        game->soundPause = (Sound){0};
-        game->soundPause.frameCount = 7;
-        game->soundLoopComplete = (Sound){0};
-        game->soundLoopComplete.frameCount = 8;
-
-        printf("=== FALLBACK AUDIO READY ===\n\n");
-        return;
-    }
-
-    printf("Audio device ready!\n");
-    game->useFallbackAudio = false;
-
-    // Generate simple sounds with lower sample rates for better compatibility
-    printf("Generating sounds...\n");
-
-    game->soundPickup = GeneratePickupSound();
-    printf("  - Pickup sound generated\n");
-
-    game->soundTurn = GenerateBeepSound(300.0f, 0.05f, 22050);
-    printf("  - Turn sound generated\n");
-
-    game->soundGameOver = GenerateGameOverSound();
-    printf("  - Game over sound generated\n");
-
-    game->soundBoost = GenerateBeepSound(1000.0f, 0.2f, 22050);
-    printf("  - Boost sound generated\n");
-
-    game->soundShield = GenerateBeepSound(600.0f, 0.25f, 22050);
-    printf("  - Shield sound generated\n");
-
-    game->soundMenuSelect = GenerateBeepSound(700.0f, 0.1f, 22050);
-    printf("  - Menu sound generated\n");
-
-    game->soundPause = GenerateBeepSound(400.0f, 0.15f, 22050);
-    printf("  - Pause sound generated\n");
+void UnloadSounds(GameState* game) {
+    GameAudio* audio = game->audio;
+    if (!audio) return;
 
-    game->soundLoopComplete = GenerateBeepSound(1200.0f, 0.3f, 22050);
-    printf("  - Loop complete sound generated\n");
+    // Let a slow device bring-up finish before tearing it down
+    Utils_JoinThread(audio->worker);
+    Audio_Shutdown();
+    Synth_UnloadBank();
 
-    // Set volumes
-    game->soundEnabled = true;
-    game->masterVolume = 1.0f;  // Maximum volume
-
-    SetMasterVolume(1.0f);
-    SetSoundVolume(game->soundPickup, 1.0f);
-    SetSoundVolume(game->soundTurn, 0.3f);  // Quieter for turn
-    SetSoundVolume(game->soundGameOver, 1.0f);
-    SetSoundVolume(game->soundBoost, 1.0f);
-    SetSoundVolume(game->soundShield, 1.0f);
-    SetSoundVolume(game->soundMenuSelect, 0.8f);
-    SetSoundVolume(game->soundPause, 0.8f);
-    SetSoundVolume(game->soundLoopComplete, 1.0f);
-
-    printf("Sound volumes set\n");
-    printf("=== AUDIO READY ===\n\n");
-
-    // Play test sound
-    printf("Playing test sound (menu select)...\n");
-    PlaySound(game->soundMenuSelect);
-
-    // Test all sounds
-    printf("Testing sound playback:\n");
-    printf("  Menu sound frameCount: %d\n", game->soundMenuSelect.frameCount);
-    printf("  Pickup sound frameCount: %d\n", game->soundPickup.frameCount);
-    printf("  Boost sound frameCount: %d\n", game->soundBoost.frameCount);
-}
-
-void UnloadSounds(GameState* game) {
-    if (!game->soundEnabled || game->useFallbackAudio) return;
-
-    printf("Unloading sounds...\n");
-    UnloadSound(game->soundPickup);
-    UnloadSound(game->soundTurn);
-    UnloadSound(game->soundGameOver);
-    UnloadSound(game->soundBoost);
-    UnloadSound(game->soundShield);
-    UnloadSound(game->soundMenuSelect);
-    UnloadSound(game->soundPause);
-    UnloadSound(game->soundLoopComplete);
-
-    printf("Closing audio device...\n");
-    CloseAudioDevice();
+    free(audio);
+    game->audio = NULL;
 }
 
 // =====================================
@@ -509,6 +378,7 @@ void SpawnParticles(GameState* game, Vector3 position, Color color, int count) {
 }
 
 void UpdateParticles(GameState* game, float deltaTime) {
+    PROFILE_BEGIN("UpdateParticles");
     for (int i = 0; i < PARTICLE_COUNT; i++) {
         if (game->particles[i].lifetime > 0) {
             game->particles[i].lifetime -= deltaTime;
@@ -525,11 +395,13 @@ void UpdateParticles(GameState* game, float deltaTime) {
             game->particles[i].color.a = alpha;
         }
     }
+
+    PROFILE_END();
 }
 
 void SpawnPowerup(GameState* game) {
     // Find inactive powerup slot
-    for (int i = 0; i < 20; i++) {
+    for (int i = 0; i < game->powerupLimit; i++) {
         if (!game->powerups[i].active) {
             game->powerups[i].active = true;
             game->powerups[i].type = rand() % POWERUP_TYPE_COUNT;
@@ -596,48 +468,24 @@ void InitLineRider(GameState* game) {
 void UpdateLineRider(GameState* game, EngineState* engine) {
     LineRider* rider = &game->rider;
     if (!rider->alive || game->paused) return;
+    PROFILE_BEGIN("UpdateLineRider");
 
     float deltaTime = engine->deltaTime * game->slowTimeMultiplier;
 
     // MAIN MECHANIC: Can only turn left!
-    float turnRate = 0.0f;
-
-    // Keyboard and mouse controls (full speed)
-    if (IsKeyDown(KEY_SPACE) || IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-        turnRate = 1.0f;
-    }
-
-    // Add gamepad controls with analog support
-    if (engine->activeGamepad >= 0) {
-        // Digital controls (full speed) - A button only
-        if (IsGamepadButtonDown(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN)) {  // A button
-            turnRate = 1.0f;
-        }
-
-        // Analog controls (variable speed)
-        float triggerValue = engine->gamepadRightTrigger[engine->activeGamepad];
-        if (triggerValue > 0.1f) {
-            turnRate = fmaxf(turnRate, triggerValue);  // Use trigger value for variable turn
-        }
-
-        // Left stick horizontal axis (only left direction)
-        float stickX = engine->gamepadLeftStick[engine->activeGamepad].x;
-        if (stickX < -0.1f) {
-            turnRate = fmaxf(turnRate, fabsf(stickX));  // Variable turn based on stick position
-        }
-    }
+    // Keys and buttons turn at full speed, the trigger and stick variably.
+    // The held average turns for the part of the frame the input was down,
+    // so short taps and late presses aren't rounded to whole frames.
+    float turnRate = engine->input.held[ACTION_TURN_LEFT];
 
     if (turnRate > 0) {
+        Telemetry_MarkLatency(engine, LATENCY_UPDATE);
         float turnAmount = TURN_SPEED * turnRate * deltaTime * game->difficultyMultiplier;
         rider->direction += turnAmount;
         rider->totalRotation += turnAmount;
 
-        // Play turn sound (with rate limiting)
-        static float lastTurnSound = 0;
-        if (game->gameTime - lastTurnSound > 0.1f) {
-            PlayTurnSound(game);
-            lastTurnSound = game->gameTime;
-        }
+        // Play turn sound (the mixer's retrigger interval rate limits it)
+        PlaySoundEffectAt(game, SFX_TURN, rider->segments[0].position);
 
         // Check for complete turns
         if (rider->totalRotation >= 2 * PI) {
@@ -645,7 +493,7 @@ void UpdateLineRider(GameState* game, EngineState* engine) {
             rider->totalRotation -= 2 * PI;
             rider->score += 100 * rider->turnsCompleted;  // Bonus for completing circles
             SpawnParticles(game, rider->segments[0].position, GOLD, 20);
-            PlayLoopCompleteSound(game);
+            PlaySoundEffectAt(game, SFX_LOOP_COMPLETE, rider->segments[0].position);
         }
     }
 
@@ -729,7 +577,8 @@ void UpdateLineRider(GameState* game, EngineState* engine) {
                 rider->alive = false;
                 game->gameOver = true;
                 SpawnParticles(game, head->position, RED, 30);
-                PlayGameOverSound(game);
+                PlaySoundEffectAt(game, SFX_COLLISION, head->position);
+                PlaySoundEffect(game, SFX_GAME_OVER);
             }
         }
     }
@@ -741,6 +590,8 @@ void UpdateLineRider(GameState* game, EngineState* engine) {
 
     // Add score over time
     rider->score += deltaTime * 10;
+
+    PROFILE_END();
 }
 
 void CollectPowerup(GameState* game, Powerup* powerup) {
@@ -750,23 +601,23 @@ void CollectPowerup(GameState* game, Powerup* powerup) {
         case POWERUP_ENERGY:
             rider->energy += ENERGY_BAR_VALUE;
             if (rider->energy > MAX_ENERGY) rider->energy = MAX_ENERGY;
-            PlayPickupSound(game);
+            PlaySoundEffectAt(game, SFX_PICKUP_ENERGY, powerup->position);
             break;
 
         case POWERUP_SPEED_BOOST:
             rider->boosted = true;
             rider->boostTimer = 5.0f;
-            PlayBoostSound(game);
+            PlaySoundEffectAt(game, SFX_PICKUP_BOOST, powerup->position);
             break;
 
         case POWERUP_SLOW_TIME:
             game->slowTimeMultiplier = 0.5f;
-            PlayPickupSound(game);
+            PlaySoundEffectAt(game, SFX_PICKUP_SLOW, powerup->position);
             break;
 
         case POWERUP_SHIELD:
             rider->shieldTimer = 10.0f;
-            PlayShieldSound(game);
+            PlaySoundEffectAt(game, SFX_PICKUP_SHIELD, powerup->position);
             break;
 
         case POWERUP_SHRINK:
@@ -777,12 +628,12 @@ void CollectPowerup(GameState* game, Powerup* powerup) {
                     rider->segmentCount = INITIAL_SEGMENTS;
                 }
             }
-            PlayPickupSound(game);
+            PlaySoundEffectAt(game, SFX_PICKUP_SHRINK, powerup->position);
             break;
 
         case POWERUP_BONUS_POINTS:
             rider->score += 500;
-            PlayPickupSound(game);
+            PlaySoundEffectAt(game, SFX_PICKUP_BONUS, powerup->position);
             break;
 
         default:
@@ -816,7 +667,7 @@ void CollectPowerup(GameState* game, Powerup* powerup) {
 void UpdatePowerups(GameState* game, float deltaTime) {
     LineRider* rider = &game->rider;
 
-    for (int i = 0; i < 20; i++) {
+    for (int i = 0; i < game->powerupLimit; i++) {
         if (!game->powerups[i].active) continue;
 
         Powerup* powerup = &game->powerups[i];
@@ -842,6 +693,7 @@ void UpdatePowerups(GameState* game, float deltaTime) {
 }
 
 void RenderLineRider(GameState* game) {
+    PROFILE_BEGIN("RenderLineRider");
     LineRider* rider = &game->rider;
 
     // Draw segments from tail to head for proper layering
@@ -906,10 +758,13 @@ void RenderLineRider(GameState* game) {
             DrawSphere(trailPos, SEGMENT_SIZE * 0.5f, trailColor);
         }
     }
+
+    PROFILE_END();
 }
 
 void RenderPowerups(GameState* game) {
-    for (int i = 0; i < 20; i++) {
+    PROFILE_BEGIN("RenderPowerups");
+    for (int i = 0; i < game->powerupLimit; i++) {
         if (!game->powerups[i].active) continue;
 
         Powerup* powerup = &game->powerups[i];
@@ -967,17 +822,23 @@ void RenderPowerups(GameState* game) {
                       Fade(fadeColor, 0.1f));
         }
     }
+
+    PROFILE_END();
 }
 
 void RenderParticles(GameState* game) {
+    PROFILE_BEGIN("RenderParticles");
     for (int i = 0; i < PARTICLE_COUNT; i++) {
         if (game->particles[i].lifetime > 0) {
             DrawSphere(game->particles[i].position, game->particles[i].size, game->particles[i].color);
         }
     }
+
+    PROFILE_END();
 }
 
 void RenderStars(GameState* game) {
+    PROFILE_BEGIN("RenderStars");
     for (int i = 0; i < STAR_COUNT; i++) {
         float twinkle = sinf(game->gameTime * 3.0f + game->stars[i].twinkle * 10.0f) * 0.3f + 0.7f;
         Color starColor = (Color){
@@ -986,9 +847,12 @@ void RenderStars(GameState* game) {
         };
         DrawSphere(game->stars[i].position, 0.1f, starColor);
     }
+
+    PROFILE_END();
 }
 
 void RenderArena(GameState* game) {
+    PROFILE_BEGIN("RenderArena");
     // Draw arena boundaries
     float halfSize = ARENA_SIZE / 2;
     Color boundaryColor = (Color){100, 100, 200, 50};
@@ -1010,28 +874,58 @@ void RenderArena(GameState* game) {
         Color warningColor = (Color){255, 255, 255, (int)(pulse * 100)};
         DrawCylinder((Vector3){0, -1, 0}, 0, halfSize * 2, 0.1f, 32, warningColor);
     }
+
+    PROFILE_END();
 }
 
+// Retained HUD text for values that change between frames
+typedef struct {
+    TextField score;
+    TextField highScore;
+    TextField fps;
+    TextField shield;
+    TextField length;
+    TextField loops;
+    TextField menuHighScore;
+    TextField menuHighScoreHardcore;
+    TextField gamepad;
+    TextField finalScore;
+    TextField pauseScore;
+    TextField pickupDistance[POWERUP_LIMIT];  // Shared by index beyond the normal limit
+} HUDText;
+
+static HUDText hudText;
+
 void RenderPickupIndicators(GameState* game, EngineState* engine) {
+    PROFILE_BEGIN("RenderPickupIndicators");
     // This function handles both ON-SCREEN and OFF-SCREEN indicators for energy pickups.
-    for (int i = 0; i < 20; i++) {
-        if (!game->powerups[i].active || game->powerups[i].type != POWERUP_ENERGY) {
-            continue;
+    // Project all of them in one batch with this frame's camera matrices.
+    static Vector3 pickupPositions[MAX_POWERUPS];
+    static Vector2 pickupScreenPositions[MAX_POWERUPS];
+    static int pickupIndices[MAX_POWERUPS];
+    int pickupCount = 0;
+    for (int i = 0; i < game->powerupLimit; i++) {
+        if (game->powerups[i].active && game->powerups[i].type == POWERUP_ENERGY) {
+            pickupIndices[pickupCount] = i;
+            pickupPositions[pickupCount++] = game->powerups[i].position;
         }
+    }
+    Utils_WorldToScreenBatch(engine, pickupPositions, pickupCount, pickupScreenPositions);
 
-        // Get actual render dimensions and center
-        int renderWidth = engine->useInternalResolution ? engine->internalWidth : engine->windowWidth;
-        int renderHeight = engine->useInternalResolution ? engine->internalHeight : engine->windowHeight;
-        float centerX = renderWidth / 2.0f;
-        float centerY = renderHeight / 2.0f;
+    // UI canvas dimensions and center
+    const CameraMatrices* view = &engine->cameraMatrices;
+    int renderWidth = view->width;
+    int renderHeight = view->height;
+    float centerX = renderWidth / 2.0f;
+    float centerY = renderHeight / 2.0f;
 
-        // Get the 3D -> 2D projection of the pickup's center
-        Vector2 screenPos = GetWorldToScreen(game->powerups[i].position, engine->camera);
+    for (int n = 0; n < pickupCount; n++) {
+        int i = pickupIndices[n];
+        Vector2 screenPos = pickupScreenPositions[n];
 
         // Check if the pickup is in front of the camera
         Vector3 toPowerup = Vector3Subtract(game->powerups[i].position, engine->camera.position);
-        Vector3 cameraForward = Vector3Normalize(Vector3Subtract(engine->camera.target, engine->camera.position));
-        float dotProduct = Vector3DotProduct(Vector3Normalize(toPowerup), cameraForward);
+        float dotProduct = Vector3DotProduct(toPowerup, view->forward);
 
         // Determine if the pickup's center is within the visible screen area
         bool isOnScreen = (dotProduct > 0.0f &&
@@ -1064,13 +958,8 @@ void RenderPickupIndicators(GameState* game, EngineState* engine) {
             // Use one consistent, reliable method for ALL off-screen objects.
             // Manually project the direction onto the camera's plane. This avoids
             // inconsistencies from using GetWorldToScreen for positioning.
-            Matrix viewMatrix = GetCameraMatrix(engine->camera);
-            Matrix invViewMatrix = MatrixInvert(viewMatrix);
-            Vector3 camRight = { invViewMatrix.m0, invViewMatrix.m1, invViewMatrix.m2 };
-            Vector3 camUp    = { invViewMatrix.m4, invViewMatrix.m5, invViewMatrix.m6 };
-
-            float rightDot = Vector3DotProduct(toPowerup, camRight);
-            float upDot = Vector3DotProduct(toPowerup, camUp);
+            float rightDot = Vector3DotProduct(toPowerup, view->right);
+            float upDot = Vector3DotProduct(toPowerup, view->up);
 
             // For objects in front but off-screen, the direction might need to be flipped.
             // When dotProduct is positive, rightDot/upDot correctly map the direction.
@@ -1130,73 +1019,79 @@ void RenderPickupIndicators(GameState* game, EngineState* engine) {
             DrawTriangleLines(arrowTip, arrowBase1, arrowBase2, outlineColor);
             float distance = Vector3Distance(game->rider.segments[0].position, game->powerups[i].position);
             int fontSize = (energyPercent < 0.2f) ? 16 : 12;
-            const char* distText = TextFormat("%.0fm", distance);
-            int textWidth = MeasureText(distText, fontSize);
+            const TextLayout* distText = Text_LayoutFloat(&hudText.pickupDistance[i % POWERUP_LIMIT], "%.0fm", distance, fontSize);
+            int textWidth = distText->width;
             Vector2 textPos = { edgeX, edgeY };
             textPos.x -= textWidth/2;
             textPos.y -= (dy > 0.5f ? arrowSize + 5 : -arrowSize - fontSize);
             textPos.x = fmaxf(5, fminf(renderWidth - textWidth - 5, textPos.x));
             textPos.y = fmaxf(5, fminf(renderHeight - fontSize - 5, textPos.y));
-            DrawText(distText, (int)textPos.x, (int)textPos.y, fontSize, outlineColor);
+            Text_DrawLayout(distText, (int)textPos.x, (int)textPos.y, outlineColor);
         }
     }
+
+    PROFILE_END();
 }
 
 void RenderUI(GameState* game, EngineState* engine) {
-    // Use internal resolution dimensions when active, otherwise use actual window size
-    int screenWidth = engine->useInternalResolution ? engine->internalWidth : engine->windowWidth;
-    int screenHeight = engine->useInternalResolution ? engine->internalHeight : engine->windowHeight;
+    PROFILE_BEGIN("RenderUI");
+    // UI canvas: internal resolution when active (drawn at native resolution), otherwise window size
+    int screenWidth = Engine_GetUIWidth(engine);
+    int screenHeight = Engine_GetUIHeight(engine);
 
     // Show menu if in menu state
     if (game->inMenu) {
-        DrawText(GAME_TITLE, screenWidth / 2 - MeasureText(GAME_TITLE, 30) / 2, 50, 30, WHITE);
-        DrawText("You can only steer LEFT!", screenWidth / 2 - MeasureText("You can only steer LEFT!", 18) / 2, 80, 18, SKYBLUE);
+        Text_DrawCentered(GAME_TITLE, screenWidth / 2, 50, 30, WHITE);
+        Text_DrawCentered("You can only steer LEFT!", screenWidth / 2, 80, 18, SKYBLUE);
 
-        DrawText("SELECT DIFFICULTY", screenWidth / 2 - MeasureText("SELECT DIFFICULTY", 20) / 2, 120, 20, YELLOW);
+        Text_DrawCentered("SELECT DIFFICULTY", screenWidth / 2, 120, 20, YELLOW);
 
         // Easy option
         Color easyColor = (game->difficulty == DIFFICULTY_EASY) ? GREEN : WHITE;
         const char* easyText = "[LEFT] EASY";
-        DrawText(easyText, screenWidth / 2 - 120, 160, 16, easyColor);
-        DrawText("Normal speed", screenWidth / 2 - 120, 180, 12, LIGHTGRAY);
-        DrawText("For beginners", screenWidth / 2 - 120, 195, 12, LIGHTGRAY);
+        Text_Draw(easyText, screenWidth / 2 - 120, 160, 16, easyColor);
+        Text_Draw("Normal speed", screenWidth / 2 - 120, 180, 12, LIGHTGRAY);
+        Text_Draw("For beginners", screenWidth / 2 - 120, 195, 12, LIGHTGRAY);
 
         // Hardcore option
         Color hardcoreColor = (game->difficulty == DIFFICULTY_HARDCORE) ? RED : WHITE;
         const char* hardcoreText = "[RIGHT] HARDCORE";
-        DrawText(hardcoreText, screenWidth / 2 + 20, 160, 16, hardcoreColor);
-        DrawText("2x speed!", screenWidth / 2 + 20, 180, 12, ORANGE);
-        DrawText("For experts", screenWidth / 2 + 20, 195, 12, ORANGE);
+        Text_Draw(hardcoreText, screenWidth / 2 + 20, 160, 16, hardcoreColor);
+        Text_Draw("2x speed!", screenWidth / 2 + 20, 180, 12, ORANGE);
+        Text_Draw("For experts", screenWidth / 2 + 20, 195, 12, ORANGE);
 
         // Start instruction
         const char* startText = (engine->activeGamepad >= 0) ? "A to start" : "Press ENTER to start";
-        DrawText(startText, screenWidth / 2 - MeasureText(startText, 16) / 2, 230, 16, LIME);
+        Text_DrawCentered(startText, screenWidth / 2, 230, 16, LIME);
 
         // High scores
-        DrawText(TextFormat("Easy High Score: %d", game->highScore), screenWidth / 2 - 150, 270, 14, WHITE);
-        DrawText(TextFormat("Hardcore High Score: %d", game->highScoreHardcore), screenWidth / 2 + 10, 270, 14, WHITE);
+        Text_DrawLayout(Text_LayoutInt(&hudText.menuHighScore, "Easy High Score: %d", game->highScore, 14),
+                        screenWidth / 2 - 150, 270, WHITE);
+        Text_DrawLayout(Text_LayoutInt(&hudText.menuHighScoreHardcore, "Hardcore High Score: %d", game->highScoreHardcore, 14),
+                        screenWidth / 2 + 10, 270, WHITE);
 
         // Show gamepad status
         if (engine->activeGamepad >= 0) {
-            DrawText(TextFormat("Gamepad %d Connected", engine->activeGamepad + 1),
-                    screenWidth / 2 - MeasureText("Gamepad 1 Connected", 12) / 2, 295, 12, LIME);
+            Text_DrawLayout(Text_LayoutInt(&hudText.gamepad, "Gamepad %d Connected", engine->activeGamepad + 1, 12),
+                            screenWidth / 2 - Text_Measure("Gamepad 1 Connected", 12) / 2, 295, LIME);
         }
 
-        DrawText("Press ESC to exit", screenWidth / 2 - MeasureText("Press ESC to exit", 12) / 2, 320, 12, DARKGRAY);
+        Text_DrawCentered("Press ESC to exit", screenWidth / 2, 320, 12, DARKGRAY);
+        PROFILE_END();
         return;
     }
 
     // Game title (smaller when playing)
-    DrawText(GAME_TITLE, screenWidth / 2 - MeasureText(GAME_TITLE, 20) / 2, 10, 20, WHITE);
+    Text_DrawCentered(GAME_TITLE, screenWidth / 2, 10, 20, WHITE);
     const char* diffText = game->difficulty == DIFFICULTY_HARDCORE ? "HARDCORE MODE" : "EASY MODE";
     Color diffColor = game->difficulty == DIFFICULTY_HARDCORE ? RED : GREEN;
-    DrawText(diffText, screenWidth / 2 - MeasureText(diffText, 14) / 2, 35, 14, diffColor);
+    Text_DrawCentered(diffText, screenWidth / 2, 35, 14, diffColor);
 
     // Score
-    DrawText(TextFormat("Score: %d", (int)game->rider.score), 10, 60, 16, WHITE);
+    Text_DrawLayout(Text_LayoutInt(&hudText.score, "Score: %d", (int)game->rider.score, 16), 10, 60, WHITE);
     int currentHighScore = (game->difficulty == DIFFICULTY_HARDCORE) ? game->highScoreHardcore : game->highScore;
     if (currentHighScore > 0) {
-        DrawText(TextFormat("High: %d", currentHighScore), 10, 80, 12, GOLD);
+        Text_DrawLayout(Text_LayoutInt(&hudText.highScore, "High: %d", currentHighScore, 12), 10, 80, GOLD);
     }
 
     // Energy bar
@@ -1211,87 +1106,87 @@ void RenderUI(GameState* game, EngineState* engine) {
     DrawRectangle(10, 100, 120, 12, DARKGRAY);
     DrawRectangle(10, 100, (int)(120 * energyPercent), 12, energyColor);
     DrawRectangleLines(10, 100, 120, 12, WHITE);
-    DrawText("ENERGY", 12, 101, 10, WHITE);
+    Text_Draw("ENERGY", 12, 101, 10, WHITE);
 
     // Boost indicator
     if (game->rider.boosted) {
-        DrawText("BOOST!", screenWidth / 2 - MeasureText("BOOST!", 24) / 2, 60, 24, YELLOW);
+        Text_DrawCentered("BOOST!", screenWidth / 2, 60, 24, YELLOW);
     }
 
     // FPS counter
     if (game->showFPS) {
         int fps = GetFPS();
         Color fpsColor = fps >= 55 ? GREEN : (fps >= 30 ? YELLOW : RED);
-        DrawText(TextFormat("FPS: %d", fps), screenWidth - 60, 5, 14, fpsColor);
+        Text_DrawLayout(Text_LayoutInt(&hudText.fps, "FPS: %d", fps, 14), screenWidth - 60, 5, fpsColor);
     }
 
     // Shield indicator
     if (game->rider.shieldTimer > 0) {
-        DrawText(TextFormat("SHIELD: %.1fs", game->rider.shieldTimer), 10, 120, 12, GREEN);
+        Text_DrawLayout(Text_LayoutFloat(&hudText.shield, "SHIELD: %.1fs", game->rider.shieldTimer, 12), 10, 120, GREEN);
     }
 
     // Segments count
-    DrawText(TextFormat("Length: %d", game->rider.segmentCount), 10, 135, 12, SKYBLUE);
+    Text_DrawLayout(Text_LayoutInt(&hudText.length, "Length: %d", game->rider.segmentCount, 12), 10, 135, SKYBLUE);
 
     // Turns completed
     if (game->rider.turnsCompleted > 0) {
-        DrawText(TextFormat("Loops: %d", game->rider.turnsCompleted), 10, 150, 12, GOLD);
+        Text_DrawLayout(Text_LayoutInt(&hudText.loops, "Loops: %d", game->rider.turnsCompleted, 12), 10, 150, GOLD);
     }
 
     // Controls
     // Control hints - update based on gamepad connection
     if (engine->activeGamepad >= 0) {
-        DrawText("SPACE/MOUSE/A/RT/L-STICK: Turn Left", screenWidth - 220, screenHeight - 20, 10, LIGHTGRAY);
-        DrawText("LB/LT/L3/R3: Camera Zoom", screenWidth - 220, screenHeight - 32, 9, DARKGRAY);
+        Text_Draw("SPACE/MOUSE/A/RT/L-STICK: Turn Left", screenWidth - 220, screenHeight - 20, 10, LIGHTGRAY);
+        Text_Draw("LB/LT/L3/R3: Camera Zoom", screenWidth - 220, screenHeight - 32, 9, DARKGRAY);
     } else {
-        DrawText("SPACE or LEFT MOUSE: Turn Left", screenWidth - 180, screenHeight - 20, 10, LIGHTGRAY);
+        Text_Draw("SPACE or LEFT MOUSE: Turn Left", screenWidth - 180, screenHeight - 20, 10, LIGHTGRAY);
     }
 
     // Sound indicator
-    DrawText(game->soundEnabled ? "Sound: ON (S to toggle)" : "Sound: OFF (S to toggle)",
+    Text_Draw(game->soundEnabled ? "Sound: ON (S to toggle)" : "Sound: OFF (S to toggle)",
              10, screenHeight - 20, 10, game->soundEnabled ? GREEN : DARKGRAY);
 
     // FPS toggle indicator
-    DrawText(game->showFPS ? "FPS: ON (F to toggle)" : "FPS: OFF (F to toggle)",
+    Text_Draw(game->showFPS ? "FPS: ON (F to toggle)" : "FPS: OFF (F to toggle)",
              10, screenHeight - 32, 10, game->showFPS ? GREEN : DARKGRAY);
 
     // Game over
     if (game->gameOver) {
         DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.7f));
-        DrawText("GAME OVER", screenWidth / 2 - MeasureText("GAME OVER", 30) / 2, screenHeight / 2 - 60, 30, RED);
-        DrawText(TextFormat("Final Score: %d", (int)game->rider.score),
-                screenWidth / 2 - MeasureText(TextFormat("Final Score: %d", (int)game->rider.score), 20) / 2,
-                screenHeight / 2 - 20, 20, WHITE);
+        Text_DrawCentered("GAME OVER", screenWidth / 2, screenHeight / 2 - 60, 30, RED);
+        const TextLayout* finalScore = Text_LayoutInt(&hudText.finalScore, "Final Score: %d", (int)game->rider.score, 20);
+        Text_DrawLayout(finalScore, screenWidth / 2 - finalScore->width / 2, screenHeight / 2 - 20, WHITE);
         const char* modeText = game->difficulty == DIFFICULTY_HARDCORE ? "HARDCORE MODE" : "EASY MODE";
         Color modeColor = game->difficulty == DIFFICULTY_HARDCORE ? ORANGE : GREEN;
-        DrawText(modeText, screenWidth / 2 - MeasureText(modeText, 14) / 2, screenHeight / 2 + 5, 14, modeColor);
-        DrawText("Press ENTER to Restart", screenWidth / 2 - MeasureText("Press ENTER to Restart", 14) / 2,
+        Text_DrawCentered(modeText, screenWidth / 2, screenHeight / 2 + 5, 14, modeColor);
+        Text_DrawCentered("Press ENTER to Restart", screenWidth / 2,
                 screenHeight / 2 + 30, 14, LIGHTGRAY);
-        DrawText("Press M for Menu", screenWidth / 2 - MeasureText("Press M for Menu", 14) / 2,
+        Text_DrawCentered("Press M for Menu", screenWidth / 2,
                 screenHeight / 2 + 50, 14, LIGHTGRAY);
-        DrawText("Press ESC to Exit", screenWidth / 2 - MeasureText("Press ESC to Exit", 14) / 2,
+        Text_DrawCentered("Press ESC to Exit", screenWidth / 2,
                 screenHeight / 2 + 70, 14, LIGHTGRAY);
     }
 
     // Pause menu
     if (game->showPauseMenu && !game->gameOver) {
         DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.8f));
-        DrawText("GAME PAUSED", screenWidth / 2 - MeasureText("GAME PAUSED", 30) / 2, screenHeight / 2 - 60, 30, YELLOW);
-        DrawText(TextFormat("Score: %d", (int)game->rider.score),
-                screenWidth / 2 - MeasureText(TextFormat("Score: %d", (int)game->rider.score), 16) / 2,
-                screenHeight / 2 - 20, 16, WHITE);
+        Text_DrawCentered("GAME PAUSED", screenWidth / 2, screenHeight / 2 - 60, 30, YELLOW);
+        const TextLayout* pauseScore = Text_LayoutInt(&hudText.pauseScore, "Score: %d", (int)game->rider.score, 16);
+        Text_DrawLayout(pauseScore, screenWidth / 2 - pauseScore->width / 2, screenHeight / 2 - 20, WHITE);
 
         const char* menuText = (engine->activeGamepad >= 0) ? "Press ENTER or A for Main Menu" : "Press ENTER for Main Menu";
-        DrawText(menuText, screenWidth / 2 - MeasureText(menuText, 14) / 2,
+        Text_DrawCentered(menuText, screenWidth / 2,
                 screenHeight / 2 + 10, 14, GREEN);
 
         const char* altMenuText = (engine->activeGamepad >= 0) ? "(or M/B for Main Menu)" : "(or M for Main Menu)";
-        DrawText(altMenuText, screenWidth / 2 - MeasureText(altMenuText, 12) / 2,
+        Text_DrawCentered(altMenuText, screenWidth / 2,
                 screenHeight / 2 + 30, 12, DARKGRAY);
 
-        DrawText("Press ESC to Resume", screenWidth / 2 - MeasureText("Press ESC to Resume", 14) / 2,
+        Text_DrawCentered("Press ESC to Resume", screenWidth / 2,
                 screenHeight / 2 + 50, 14, LIGHTGRAY);
     }
+
+    PROFILE_END();
 }
 
 void InitGame(GameState* game) {
@@ -1301,16 +1196,9 @@ void InitGame(GameState* game) {
     int savedHighScoreHardcore = game->highScoreHardcore;
 
     // Preserve sound system - IMPORTANT: Don't wipe out sounds!
-    Sound savedSoundPickup = game->soundPickup;
-    Sound savedSoundTurn = game->soundTurn;
-    Sound savedSoundGameOver = game->soundGameOver;
-    Sound savedSoundBoost = game->soundBoost;
-    Sound savedSoundShield = game->soundShield;
-    Sound savedSoundMenuSelect = game->soundMenuSelect;
-    Sound savedSoundPause = game->soundPause;
-    Sound savedSoundLoopComplete = game->soundLoopComplete;
+    // (the audio worker may still be filling them in)
+    GameAudio* savedAudio = game->audio;
     bool savedSoundEnabled = game->soundEnabled;
-    bool savedUseFallbackAudio = game->useFallbackAudio;
     float savedMasterVolume = game->masterVolume;
     bool savedShowFPS = game->showFPS;
 
@@ -1322,16 +1210,8 @@ void InitGame(GameState* game) {
     game->highScoreHardcore = savedHighScoreHardcore;
 
     // Restore sound system
-    game->soundPickup = savedSoundPickup;
-    game->soundTurn = savedSoundTurn;
-    game->soundGameOver = savedSoundGameOver;
-    game->soundBoost = savedSoundBoost;
-    game->soundShield = savedSoundShield;
-    game->soundMenuSelect = savedSoundMenuSelect;
-    game->soundPause = savedSoundPause;
-    game->soundLoopComplete = savedSoundLoopComplete;
+    game->audio = savedAudio;
     game->soundEnabled = savedSoundEnabled;
-    game->useFallbackAudio = savedUseFallbackAudio;
     game->masterVolume = savedMasterVolume;
     game->showFPS = savedShowFPS;
 
@@ -1346,6 +1226,7 @@ void InitGame(GameState* game) {
     game->showPauseMenu = false;
     game->cameraShake = 0;
     game->powerupSpawnTimer = 2.0f / game->difficultyMultiplier;
+    game->powerupLimit = POWERUP_LIMIT;
 
     InitLineRider(game);
     InitStars(game);
@@ -1357,10 +1238,12 @@ void InitGame(GameState* game) {
 }
 
 void UpdateGame(GameState* game, EngineState* engine) {
+    PROFILE_BEGIN("UpdateGame");
     float deltaTime = engine->deltaTime;
+    const InputFrame* input = &engine->input;
 
     // Handle ESC key
-    if (IsKeyPressed(KEY_ESCAPE)) {
+    if (input->pressed[ACTION_CANCEL]) {
         if (game->inMenu) {
             // Quit game from main menu
             engine->running = false;
@@ -1368,58 +1251,55 @@ void UpdateGame(GameState* game, EngineState* engine) {
             // Close pause menu and resume game
             game->showPauseMenu = false;
             game->paused = false;
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_SELECT);
         } else if (!game->gameOver) {
             // Open pause menu during gameplay
             game->showPauseMenu = true;
             game->paused = true;
-            PlayPauseSound(game);
+            PlaySoundEffect(game, SFX_PAUSE);
         }
     }
 
     // Handle menu input
     if (game->inMenu) {
         // Keyboard or gamepad D-pad for difficulty selection
-        if (IsKeyPressed(KEY_LEFT) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_LEFT))) {
+        if (input->pressed[ACTION_MENU_LEFT]) {
             game->difficulty = DIFFICULTY_EASY;
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_MOVE);
         }
-        if (IsKeyPressed(KEY_RIGHT) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_LEFT_FACE_RIGHT))) {
+        if (input->pressed[ACTION_MENU_RIGHT]) {
             game->difficulty = DIFFICULTY_HARDCORE;
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_MOVE);
         }
         // Start game with Enter or gamepad A button
-        if (IsKeyPressed(KEY_ENTER) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+        if (input->pressed[ACTION_CONFIRM]) {
             game->inMenu = false;
             InitGame(game);
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_SELECT);
         }
+        PROFILE_END();
         return;
     }
 
     // Handle pause menu input
     if (game->showPauseMenu) {
         // Go to main menu with Enter or gamepad A button
-        if (IsKeyPressed(KEY_ENTER) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+        if (input->pressed[ACTION_CONFIRM]) {
             game->inMenu = true;
             game->showPauseMenu = false;
             game->paused = false;
             game->gameOver = false;
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_SELECT);
         }
         // Return to main menu with M key or gamepad B button
-        if (IsKeyPressed(KEY_M) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT))) {
+        if (input->pressed[ACTION_BACK]) {
             game->inMenu = true;
             game->showPauseMenu = false;
             game->paused = false;
             game->gameOver = false;
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_SELECT);
         }
+        PROFILE_END();
         return;
     }
 
@@ -1429,21 +1309,19 @@ void UpdateGame(GameState* game, EngineState* engine) {
     }
 
     // Handle pause with P key (toggle simple pause, not pause menu)
-    if ((IsKeyPressed(KEY_P) ||
-         (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_MIDDLE_RIGHT)))
-        && !game->gameOver && !game->showPauseMenu) {
+    if (input->pressed[ACTION_PAUSE] && !game->gameOver && !game->showPauseMenu) {
         game->paused = !game->paused;
-        PlayPauseSound(game);
+        PlaySoundEffect(game, SFX_PAUSE);
     }
 
     // Toggle sound with S key
-    if (IsKeyPressed(KEY_S)) {
+    if (input->pressed[ACTION_TOGGLE_SOUND]) {
         game->soundEnabled = !game->soundEnabled;
-        if (game->soundEnabled) PlayMenuSound(game);
+        if (game->soundEnabled) PlaySoundEffect(game, SFX_MENU_SELECT);
     }
 
     // Toggle FPS display with F key
-    if (IsKeyPressed(KEY_F)) {
+    if (input->pressed[ACTION_TOGGLE_FPS]) {
         game->showFPS = !game->showFPS;
     }
 
@@ -1461,23 +1339,24 @@ void UpdateGame(GameState* game, EngineState* engine) {
         }
 
         // Restart with Enter or gamepad A button
-        if (IsKeyPressed(KEY_ENTER) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+        if (input->pressed[ACTION_CONFIRM]) {
             InitGame(game);
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_SELECT);
+            PROFILE_END();
             return;
         }
         // Return to menu with M key or gamepad B button
-        if (IsKeyPressed(KEY_M) ||
-            (engine->activeGamepad >= 0 && IsGamepadButtonPressed(engine->activeGamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT))) {
+        if (input->pressed[ACTION_BACK]) {
             game->inMenu = true;
             game->gameOver = false;
-            PlayMenuSound(game);
+            PlaySoundEffect(game, SFX_MENU_SELECT);
+            PROFILE_END();
             return;
         }
     }
 
     if (game->paused || game->gameOver) {
+        PROFILE_END();
         return;
     }
 
@@ -1507,16 +1386,194 @@ void UpdateGame(GameState* game, EngineState* engine) {
         game->cameraShake -= deltaTime * 2.0f;
         if (game->cameraShake < 0) game->cameraShake = 0;
     }
+
+    PROFILE_END();
+}
+
+// =====================================
+// Stress Scenes
+// =====================================
+
+#define STRESS_DEFAULT_FRAMES 600
+#define STRESS_WARMUP_FRAMES 60   // Dropped from the report (shader and cache warmup)
+#define STRESS_SEED 1234
+#define STRESS_CUBE_COUNT 10000
+
+typedef enum {
+    STRESS_NONE,
+    STRESS_CUBES,
+    STRESS_RIDER,
+    STRESS_PARTICLES,
+    STRESS_POWERUPS
+} StressScene;
+
+static const char* stressSceneNames[] = { "none", "cubes", "rider", "particles", "powerups" };
+
+StressScene ParseStressScene(const char* name) {
+    for (int i = STRESS_CUBES; i <= STRESS_POWERUPS; i++) {
+        if (strcmp(name, stressSceneNames[i]) == 0) return (StressScene)i;
+    }
+    return STRESS_NONE;
+}
+
+PacingMode ParsePacingMode(const char* name) {
+    for (int i = 0; i < PACING_MODE_COUNT; i++) {
+        if (strcmp(name, Engine_GetPacingName((PacingMode)i)) == 0) return (PacingMode)i;
+    }
+    return PACING_MODE_COUNT;
+}
+
+// Start a game and push one system to its limit
+void InitStressScene(GameState* game, EngineState* engine, StressScene scene) {
+    // Same content every run, and frames as fast as the GPU allows
+    srand(STRESS_SEED);
+    Engine_SetPacing(engine, PACING_UNCAPPED, 0, false);
+
+    game->difficulty = DIFFICULTY_EASY;
+    InitGame(game);
+
+    switch (scene) {
+        case STRESS_CUBES: {
+            // Square grid of engine entities centred on the arena
+            int side = (int)ceilf(sqrtf((float)STRESS_CUBE_COUNT));
+            for (int i = 0; i < STRESS_CUBE_COUNT; i++) {
+                Entity* entity = Entity_Create(engine, ENTITY_TYPE_UNIT);
+                if (!entity) break;
+                Entity_SetPosition(engine, entity, (Vector3){
+                    (i % side - side / 2) * 1.5f,
+                    0.5f,
+                    (i / side - side / 2) * 1.5f
+                });
+                entity->color = (Color){ 60 + rand() % 196, 60 + rand() % 196, 60 + rand() % 196, 255 };
+            }
+            break;
+        }
+        case STRESS_RIDER: {
+            // Longest rider, laid out behind the head like InitLineRider does
+            LineRider* rider = &game->rider;
+            for (int i = rider->segmentCount; i < MAX_SEGMENTS; i++) {
+                rider->segments[i] = rider->segments[rider->segmentCount - 1];
+                rider->segments[i].position = (Vector3){ 0, 0.5f, -i * SEGMENT_SPACING };
+                rider->segments[i].previousPos = rider->segments[i].position;
+                rider->segments[i].isHead = false;
+            }
+            rider->segmentCount = MAX_SEGMENTS;
+            break;
+        }
+        case STRESS_POWERUPS:
+            game->powerupLimit = MAX_POWERUPS;
+            for (int i = 0; i < MAX_POWERUPS; i++) {
+                SpawnPowerup(game);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Per-frame driver: keeps the scene saturated and flies a fixed camera path
+void UpdateStressScene(GameState* game, EngineState* engine, StressScene scene, int frame, int frameCount) {
+    // The rider must survive the whole run
+    game->rider.energy = MAX_ENERGY;
+    game->rider.shieldTimer = 1.0f;
+
+    if (scene == STRESS_PARTICLES) {
+        // Refill every particle that died last frame
+        for (int i = 0; i < 8; i++) {
+            Vector3 position = { (float)(rand() % 60 - 30), 1.0f, (float)(rand() % 60 - 30) };
+            SpawnParticles(game, position, ORANGE, PARTICLE_COUNT / 8);
+        }
+    } else if (scene == STRESS_POWERUPS) {
+        for (int i = 0; i < game->powerupLimit; i++) {
+            game->powerups[i].lifetime = POWERUP_LIFETIME;
+        }
+    }
+
+    // One full orbit around the arena, zooming in and out twice
+    float t = (float)frame / frameCount;
+    engine->viewMode = VIEW_MODE_ORBIT;
+    engine->orbitCamera.target = (Vector3){ 0, 0, 0 };
+    engine->orbitCamera.rotationH = PI * 0.25f + t * 2.0f * PI;
+    engine->orbitCamera.rotationV = PI * 0.3f;
+    engine->orbitCamera.distance = 60.0f + sinf(t * 4.0f * PI) * 25.0f;
+}
+
+void ReportStressScene(StressScene scene, int frameCount) {
+    printf("STRESS scene=%s frames=%d warmup=%d build=%s\n",
+           stressSceneNames[scene], frameCount, STRESS_WARMUP_FRAMES, BUILD_ID);
+
+    for (int metric = 0; metric < TELEMETRY_METRIC_COUNT; metric++) {
+        TelemetrySummary summary;
+        Telemetry_GetSummary((TelemetryMetric)metric, &summary);
+        if (summary.count == 0 && metric >= TELEMETRY_INPUT_TO_UPDATE) continue;  // Latency probe unused
+        printf("  %-7s n=%lld mean=%.3fms p50=%.3fms p95=%.3fms p99=%.3fms max=%.3fms\n",
+               Telemetry_GetMetricName((TelemetryMetric)metric), summary.count,
+               summary.meanMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs);
+    }
+
+#ifdef PROFILER_ENABLED
+    const char* zoneNames[PROFILER_MAX_ZONES];
+    double zoneMs[PROFILER_MAX_ZONES];
+    int zoneCount = Profiler_GetZoneAverages(zoneNames, zoneMs, PROFILER_MAX_ZONES);
+    printf("  zones (mean self time over the last %d frames):\n", PROFILER_HISTORY_FRAMES);
+    for (int i = 0; i < zoneCount; i++) {
+        printf("    %-24s %.3fms\n", zoneNames[i], zoneMs[i]);
+    }
+#else
+    printf("  zones: build with the profiler (debug, or -DENABLE_PROFILER) for a breakdown\n");
+#endif
 }
 
 // =====================================
 // Main Program
 // =====================================
 
+#ifndef SPACE_IS_LEFT_NO_MAIN  // Defined when bench.c includes this file
 int main(int argc, char* argv[]) {
-    // Suppress unused parameter warnings
-    (void)argc;
-    (void)argv;
+    // Time every startup phase from here to the first presented frame
+    Telemetry_BeginStartup();
+
+    // Command line options
+    bool startupReport = false;
+    const char* audioWavPath = NULL;
+    bool measureLatency = false;
+    bool writeTelemetry = false;
+    PacingMode pacingMode = PACING_VSYNC;
+    int targetFps = DEFAULT_FPS;
+    bool lateLatch = false;
+    int traceFrames = 0;
+    StressScene stressScene = STRESS_NONE;
+    int stressFrames = STRESS_DEFAULT_FRAMES;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--stress") == 0 && i + 1 < argc &&
+                   (stressScene = ParseStressScene(argv[i + 1])) != STRESS_NONE) {
+            i++;
+        } else if (strcmp(argv[i], "--stress-frames") == 0 && i + 1 < argc) {
+            stressFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--startup-report") == 0) {
+            startupReport = true;
+        } else if (strcmp(argv[i], "--audio-wav") == 0 && i + 1 < argc) {
+            audioWavPath = argv[++i];
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            measureLatency = true;
+        } else if (strcmp(argv[i], "--telemetry") == 0) {
+            writeTelemetry = true;
+        } else if (strcmp(argv[i], "--pacing") == 0 && i + 1 < argc &&
+                   (pacingMode = ParsePacingMode(argv[i + 1])) != PACING_MODE_COUNT) {
+            i++;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            targetFps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--late-latch") == 0) {
+            lateLatch = true;
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            printf("Usage: %s [--trace <frames>] [--stress cubes|rider|particles|powerups] [--stress-frames <n>] [--startup-report] [--audio-wav <file>] [--latency] [--telemetry] [--pacing vsync|uncapped|limiter] [--fps <n>] [--late-latch]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (stressFrames <= STRESS_WARMUP_FRAMES) stressFrames = STRESS_WARMUP_FRAMES + 1;
 
     // Initialize random seed
     srand(time(NULL));
@@ -1543,7 +1600,7 @@ int main(int argc, char* argv[]) {
     game->difficultyMultiplier = 1.0f;
 
     // Initialize sound system
-    InitSounds(game);
+    InitSounds(game, audioWavPath);
 
     // Enable FPS counter by default
     game->showFPS = true;
@@ -1562,14 +1619,57 @@ int main(int argc, char* argv[]) {
 
     // Disable some default debug displays for cleaner look
     engine->showDebugInfo = false;
+    engine->measureLatency = measureLatency;
+    engine->writeTelemetry = writeTelemetry;
+    if (pacingMode != PACING_VSYNC || targetFps != DEFAULT_FPS || lateLatch) {
+        Engine_SetPacing(engine, pacingMode, targetFps, lateLatch);
+    }
+
+    // Capture a trace of the first frames if requested
+    if (traceFrames > 0) {
+#ifdef PROFILER_ENABLED
+        Profiler_StartCapture(traceFrames);
+#else
+        printf("--trace needs a build with the profiler (debug, or -DENABLE_PROFILER)\n");
+#endif
+    }
+
+    // Scripted benchmark run instead of the menu
+    int stressFrame = 0;
+    if (stressScene != STRESS_NONE) {
+        InitStressScene(game, engine, stressScene);
+    }
+    Telemetry_MarkStartup("game state");
+    bool firstFrame = true;
 
     // Main game loop
     while (!Engine_ShouldClose(engine)) {
+        PROFILE_FRAME();
+
+        // Poll once; the game, camera and engine toggles all read engine->input.
+        // With late latch this waits first, so input is as fresh as possible.
+        Engine_LatchFrame(engine);
+        Input_Update(engine);
+
+        if (stressScene != STRESS_NONE) {
+            if (stressFrame == STRESS_WARMUP_FRAMES) Telemetry_Reset();
+            if (stressFrame == stressFrames) {
+                ReportStressScene(stressScene, stressFrames);
+                break;
+            }
+            UpdateStressScene(game, engine, stressScene, stressFrame++, stressFrames);
+        }
+
         // Update game
+        long long updateStartNs = Utils_GetTimeNs();
         UpdateGame(game, engine);
+        if (!engine->idle) {
+            Telemetry_Record(TELEMETRY_UPDATE, Utils_GetTimeNs() - updateStartNs);
+        }
+        UpdateMusic(game);
 
         // Follow the line rider head with camera (skip if in menu)
-        if (game->rider.alive && !game->paused && !game->inMenu) {
+        if (game->rider.alive && !game->paused && !game->inMenu && stressScene == STRESS_NONE) {
             Vector3 headPos = game->rider.segments[0].position;
 
             if (engine->viewMode == VIEW_MODE_ORBIT) {
@@ -1603,35 +1703,73 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        // Begin frame
-        Engine_BeginFrame(engine);
+        // Menus, pause and game over only animate in response to input,
+        // so let the engine skip redraws until something changes
+        Engine_SetIdle(engine, game->inMenu || game->paused || game->gameOver);
+
+        // Begin frame (skipped while idle and nothing changed)
+        if (!Engine_BeginFrame(engine)) {
+            continue;
+        }
+        UpdateSoundListener(game, engine);
 
         // Render game world (skip if in menu)
         if (!game->inMenu) {
+            Render_StatsBeginZone(engine, "stars");
             RenderStars(game);
-            RenderArena(game);
-
+            Render_StatsEndZone(engine);
 
+            Render_StatsBeginZone(engine, "arena");
+            RenderArena(game);
+            Render_StatsEndZone(engine);
 
             // Render game objects
+            Render_StatsBeginZone(engine, "powerups");
             RenderPowerups(game);
+            Render_StatsEndZone(engine);
+
+            Render_StatsBeginZone(engine, "rider");
             RenderLineRider(game);
+            Render_StatsEndZone(engine);
+            Telemetry_MarkLatency(engine, LATENCY_DRAW);
+
+            Render_StatsBeginZone(engine, "particles");
             RenderParticles(game);
+            Render_StatsEndZone(engine);
+
+            // Engine entities (only the stress cubes scene creates any)
+            if (engine->entityCount > 0) {
+                Render_StatsBeginZone(engine, "entities");
+                PROFILE_BEGIN("RenderEntities");
+                Entity_RenderAll(engine);
+                PROFILE_END();
+                Render_StatsEndZone(engine);
+            }
         }
 
         // End 3D mode to begin 2D UI rendering
         Engine_End3D(engine);
 
         // Render UI overlay (2D elements)
+        Render_StatsBeginZone(engine, "ui");
         RenderUI(game, engine);
+        Render_StatsEndZone(engine);
 
         // Render off-screen indicators for energy pickups (skip if in menu)
         if (game->rider.alive && !game->paused && !game->gameOver && !game->inMenu) {
+            Render_StatsBeginZone(engine, "indicators");
             RenderPickupIndicators(game, engine);
+            Render_StatsEndZone(engine);
         }
 
         // Finalize frame and draw to screen
         Engine_EndFrame(engine);
+
+        if (firstFrame) {
+            Telemetry_MarkStartup("first frame");
+            if (startupReport) Telemetry_ReportStartup();
+            firstFrame = false;
+        }
     }
 
     // Save high score if needed
@@ -1647,3 +1785,4 @@ int main(int argc, char* argv[]) {
 
     return 0;
 }
+#endif // SPACE_IS_LEFT_NO_MAIN
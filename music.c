@@ -0,0 +1,232 @@
+#include "engine.h"
+#include <math.h>
+#include <string.h>
+
+// =====================================
+// Procedural Music Implementation
+// =====================================
+
+// Runs inside the mixer: everything here is fixed-size and allocation-free,
+// and each voice renders a whole run of samples between two sequencer steps
+// with flat loops the compiler can vectorize.
+
+#define MUSIC_STEPS 16                 // Sixteenth notes per bar
+#define MUSIC_BARS 4                   // Length of the chord progression
+#define MUSIC_AMPLITUDE 5000.0f        // Full-scale voice level in 16-bit units
+#define MUSIC_SMOOTHING 0.05f          // Per-block approach of tempo and intensity to the game's values
+
+typedef enum {
+    MUSIC_BASS,
+    MUSIC_LEAD,
+    MUSIC_KICK,
+    MUSIC_HAT,
+    MUSIC_VOICE_COUNT
+} MusicVoiceId;
+
+typedef struct {
+    SynthWaveform waveform;
+    float phase;                   // Cycles, wrapped to [0, 1)
+    float increment;               // Cycles per sample
+    float glide;                   // Increment change per sample (kick pitch drop)
+    float level;                   // Envelope level, falls linearly to zero
+    float fall;                    // Envelope drop per sample
+    float gain;
+    float panLeft;
+    float panRight;
+    unsigned int noise;
+} MusicVoice;
+
+// Am - F - C - G, as semitones from A and the third of each chord
+static const int progressionRoot[MUSIC_BARS] = { 0, -4, 3, -2 };
+static const int progressionThird[MUSIC_BARS] = { 3, 4, 4, 4 };
+
+// Step patterns, bit n set = trigger on sixteenth n
+#define PATTERN_BASS_CALM 0x0101u      // Downbeat and half bar
+#define PATTERN_BASS_DRIVE 0x4949u     // Syncopated 3-3-2
+#define PATTERN_KICK 0x1111u           // Four on the floor
+#define PATTERN_HAT_OFFBEAT 0x4444u
+#define PATTERN_HAT_BUSY 0xAAAAu
+#define PATTERN_LEAD_EIGHTHS 0x5555u
+#define PATTERN_LEAD_SIXTEENTHS 0xFFFFu
+
+static MusicVoice voices[MUSIC_VOICE_COUNT] = {
+    [MUSIC_BASS] = { .waveform = SYNTH_WAVE_TRIANGLE, .panLeft = 1.0f, .panRight = 1.0f },
+    [MUSIC_LEAD] = { .waveform = SYNTH_WAVE_SQUARE, .panLeft = 0.6f, .panRight = 1.0f },
+    [MUSIC_KICK] = { .waveform = SYNTH_WAVE_TRIANGLE, .panLeft = 1.0f, .panRight = 1.0f },
+    [MUSIC_HAT] = { .waveform = SYNTH_WAVE_NOISE, .panLeft = 1.0f, .panRight = 0.6f, .noise = 0x9E3779B9u }
+};
+static float musicLeft[AUDIO_BUFFER_FRAMES];
+static float musicRight[AUDIO_BUFFER_FRAMES];
+static float wave[AUDIO_BUFFER_FRAMES];
+
+// Sequencer state, mixer thread only
+static MusicState current = { 0.0f, 0.0f, 0.0f };  // Smoothed copy of the game's state
+static int step = 0;
+static int stepFramesLeft = 0;
+static int arpIndex = 0;
+
+// Game state triple buffer, same scheme as the audio listener: the game
+// thread fills states[stateWrite] and swaps it into stateShared
+#define STATE_FRESH 4u
+static MusicState states[3];
+static unsigned int stateShared = 1;
+static unsigned int stateWrite = 0;    // Game thread only
+static unsigned int stateRead = 2;     // Mixer only
+
+void Music_SetState(const MusicState* state) {
+    if (!state) return;
+    states[stateWrite] = *state;
+    stateWrite = __atomic_exchange_n(&stateShared, stateWrite | STATE_FRESH, __ATOMIC_ACQ_REL) & 3u;
+}
+
+static const MusicState* Music_GetState(void) {
+    if (__atomic_load_n(&stateShared, __ATOMIC_RELAXED) & STATE_FRESH) {
+        stateRead = __atomic_exchange_n(&stateShared, stateRead, __ATOMIC_ACQ_REL) & 3u;
+    }
+    return &states[stateRead];
+}
+
+static float Music_NoteIncrement(float baseFrequency, int semitones) {
+    return baseFrequency * powf(2.0f, semitones / 12.0f) / AUDIO_SAMPLE_RATE;
+}
+
+static void Music_Trigger(MusicVoice* voice, float increment, float seconds, float gain) {
+    voice->phase = 0.25f;  // Zero crossing of the triangle, so notes start without a click
+    voice->increment = increment;
+    voice->glide = 0.0f;
+    voice->level = 1.0f;
+    voice->fall = 1.0f / (seconds * AUDIO_SAMPLE_RATE);
+    voice->gain = gain;
+}
+
+// Start the notes for the current step; called once per sixteenth
+static void Music_Step(float stepSeconds) {
+    int bar = (step / MUSIC_STEPS) % MUSIC_BARS;
+    unsigned int bit = 1u << (step % MUSIC_STEPS);
+    int root = progressionRoot[bar];
+    float intensity = current.intensity;
+
+    unsigned int bass = (intensity > 0.5f) ? PATTERN_BASS_DRIVE : PATTERN_BASS_CALM;
+    if (bass & bit) {
+        Music_Trigger(&voices[MUSIC_BASS], Music_NoteIncrement(55.0f, root), stepSeconds * 2.5f, 0.9f);
+    }
+
+    if (intensity > 0.25f && (PATTERN_KICK & bit)) {
+        MusicVoice* kick = &voices[MUSIC_KICK];
+        Music_Trigger(kick, 160.0f / AUDIO_SAMPLE_RATE, 0.12f, 1.0f);
+        kick->glide = -kick->increment * 0.7f * kick->fall;  // Drops to 30% pitch as it fades
+    }
+
+    unsigned int hat = (intensity > 0.8f) ? PATTERN_HAT_BUSY : PATTERN_HAT_OFFBEAT;
+    if (intensity > 0.55f && (hat & bit)) {
+        Music_Trigger(&voices[MUSIC_HAT], 0.0f, 0.04f, 0.3f * intensity);
+    }
+
+    unsigned int lead = (intensity > 0.75f) ? PATTERN_LEAD_SIXTEENTHS : PATTERN_LEAD_EIGHTHS;
+    if (intensity > 0.4f && (lead & bit)) {
+        const int chord[4] = { 0, progressionThird[bar], 7, 12 };
+        int note = root + chord[arpIndex++ & 3];
+        Music_Trigger(&voices[MUSIC_LEAD], Music_NoteIncrement(220.0f, note), 0.12f, 0.25f + 0.25f * intensity);
+    }
+
+    step = (step + 1) % (MUSIC_STEPS * MUSIC_BARS);
+}
+
+// Add frames of one voice into the music buses
+static void Music_RenderVoice(MusicVoice* voice, float* left, float* right, int frames) {
+    if (voice->level <= 0.0f) return;
+
+    const float phase = voice->phase;
+    const float increment = voice->increment;
+    const float halfGlide = 0.5f * voice->glide;
+
+    switch (voice->waveform) {
+        case SYNTH_WAVE_TRIANGLE:
+            for (int i = 0; i < frames; i++) {
+                float p = phase + increment * i + halfGlide * i * i;
+                p -= (float)(int)p;
+                wave[i] = 4.0f * fabsf(p - 0.5f) - 1.0f;
+            }
+            break;
+        case SYNTH_WAVE_SQUARE:
+            for (int i = 0; i < frames; i++) {
+                float p = phase + increment * i;
+                p -= (float)(int)p;
+                wave[i] = 1.0f - 2.0f * (float)(int)(2.0f * p);
+            }
+            break;
+        case SYNTH_WAVE_NOISE:
+            for (int i = 0; i < frames; i++) {
+                voice->noise ^= voice->noise << 13;
+                voice->noise ^= voice->noise >> 17;
+                voice->noise ^= voice->noise << 5;
+                wave[i] = (float)(int)voice->noise * (1.0f / 2147483648.0f);
+            }
+            break;
+        default:
+            return;
+    }
+
+    // Linear decay, clamped at zero without branches
+    const float level = voice->level;
+    const float fall = voice->fall;
+    const float gainLeft = voice->gain * voice->panLeft;
+    const float gainRight = voice->gain * voice->panRight;
+    for (int i = 0; i < frames; i++) {
+        float envelope = level - fall * i;
+        envelope = 0.5f * (envelope + fabsf(envelope));
+        float sample = wave[i] * envelope;
+        left[i] += sample * gainLeft;
+        right[i] += sample * gainRight;
+    }
+
+    float end = phase + increment * frames + halfGlide * frames * frames;
+    voice->phase = end - (float)(int)end;
+    voice->increment += voice->glide * frames;
+    voice->level -= fall * frames;
+    if (voice->level <= 0.0f) voice->glide = 0.0f;
+}
+
+void Music_Render(float* left, float* right, int frames) {
+    const MusicState* target = Music_GetState();
+    float startVolume = current.volume;
+
+    current.volume = target->volume;
+    if (startVolume <= 0.0f && current.volume <= 0.0f) return;
+
+    // Ease towards the game's values so tempo and layers change smoothly
+    if (current.tempo <= 0.0f) current = *target;
+    current.tempo += (target->tempo - current.tempo) * MUSIC_SMOOTHING;
+    current.intensity += (target->intensity - current.intensity) * MUSIC_SMOOTHING;
+    if (current.tempo < 30.0f) current.tempo = 30.0f;
+
+    memset(musicLeft, 0, sizeof(float) * frames);
+    memset(musicRight, 0, sizeof(float) * frames);
+
+    // Split the block at sequencer steps
+    float stepSeconds = 15.0f / current.tempo;
+    for (int offset = 0; offset < frames; ) {
+        if (stepFramesLeft <= 0) {
+            Music_Step(stepSeconds);
+            stepFramesLeft = (int)(stepSeconds * AUDIO_SAMPLE_RATE);
+        }
+
+        int count = frames - offset;
+        if (count > stepFramesLeft) count = stepFramesLeft;
+        for (int v = 0; v < MUSIC_VOICE_COUNT; v++) {
+            Music_RenderVoice(&voices[v], musicLeft + offset, musicRight + offset, count);
+        }
+
+        offset += count;
+        stepFramesLeft -= count;
+    }
+
+    // Volume ramps across the block so pausing doesn't click
+    float gain = startVolume * MUSIC_AMPLITUDE;
+    float gainStep = (current.volume - startVolume) * MUSIC_AMPLITUDE / frames;
+    for (int i = 0; i < frames; i++) {
+        float g = gain + gainStep * i;
+        left[i] += musicLeft[i] * g;
+        right[i] += musicRight[i] * g;
+    }
+}
@@ -0,0 +1,412 @@
+#include "engine.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// =====================================
+// Frame Profiler Implementation
+// =====================================
+
+// One completed zone inside a frame
+typedef struct {
+    int zone;
+    int depth;
+    long long startNs;
+    long long endNs;
+} ProfilerEvent;
+
+// Named value sampled during a frame
+typedef struct {
+    const char* name;
+    double value;
+} ProfilerCounter;
+
+// Everything recorded between two Profiler_FrameMark() calls
+typedef struct {
+    long long startNs;
+    long long endNs;
+    int eventCount;
+    ProfilerEvent events[PROFILER_MAX_EVENTS];
+    int counterCount;
+    ProfilerCounter counters[PROFILER_MAX_COUNTERS];
+    long long zoneSelfNs[PROFILER_MAX_ZONES];  // Time in each zone minus its children
+} ProfilerFrame;
+
+// Open zone on the nesting stack
+typedef struct {
+    int zone;
+    int event;                     // Index into the frame's events, -1 if they ran out
+    long long startNs;
+    long long childNs;
+} ProfilerScope;
+
+static ProfilerFrame frames[PROFILER_HISTORY_FRAMES];
+static int currentFrame = 0;
+static int completedFrames = 0;
+static bool frameStarted = false;
+
+static const char* zoneNames[PROFILER_MAX_ZONES];
+static int zoneCount = 0;
+
+static ProfilerScope stack[PROFILER_MAX_DEPTH];
+static int depth = 0;
+
+// Zones are only recorded from the thread that marks frames
+static unsigned long mainThreadId = 0;
+
+// Trace capture: completed frames are copied here and written out on stop
+static ProfilerFrame* captureFrames = NULL;
+static int captureCapacity = 0;
+static int captureCount = 0;
+
+// Zone on a thread other than the main one; these only go to trace captures
+typedef struct {
+    const char* name;
+    unsigned long threadId;
+    long long startNs;
+    long long endNs;
+} ProfilerThreadEvent;
+
+// Worker threads reserve slots with an atomic counter. Stopping a capture
+// clears threadCapturing, then waits for threadWriters to drain before the
+// buffer is read and freed.
+static ProfilerThreadEvent* threadEvents = NULL;
+static int threadEventCapacity = 0;
+static int threadEventCount = 0;   // Slots reserved, may run past the capacity
+static int threadCapturing = 0;
+static int threadWriters = 0;
+
+// Nesting stack of the calling thread, for zones off the main thread
+static __thread ProfilerThreadEvent threadStack[PROFILER_MAX_DEPTH];
+static __thread int threadDepth = 0;
+
+// Zone names are string literals, so a pointer match almost always hits
+static int Profiler_FindZone(const char* name) {
+    for (int i = 0; i < zoneCount; i++) {
+        if (zoneNames[i] == name) return i;
+    }
+    for (int i = 0; i < zoneCount; i++) {
+        if (strcmp(zoneNames[i], name) == 0) return i;
+    }
+    if (zoneCount >= PROFILER_MAX_ZONES) return -1;
+    
+    zoneNames[zoneCount] = name;
+    return zoneCount++;
+}
+
+void Profiler_FrameMark(void) {
+    long long now = Utils_GetTimeNs();
+    
+    if (frameStarted) {
+        frames[currentFrame].endNs = now;
+        
+        if (captureFrames) {
+            captureFrames[captureCount++] = frames[currentFrame];
+            if (captureCount >= captureCapacity) Profiler_StopCapture();
+        }
+        
+        currentFrame = (currentFrame + 1) % PROFILER_HISTORY_FRAMES;
+        if (completedFrames < PROFILER_HISTORY_FRAMES) completedFrames++;
+    } else {
+        mainThreadId = Utils_GetThreadId();
+    }
+    
+    // Zones never straddle frames; drop any left open by mistake
+    depth = 0;
+    
+    ProfilerFrame* frame = &frames[currentFrame];
+    frame->startNs = now;
+    frame->endNs = now;
+    frame->eventCount = 0;
+    frame->counterCount = 0;
+    memset(frame->zoneSelfNs, 0, sizeof(frame->zoneSelfNs));
+    frameStarted = true;
+}
+
+// Worker thread zones skip the frame history: they would race the main
+// thread, and the graph only shows the main thread's frames anyway
+static void Profiler_BeginThreadZone(const char* name, unsigned long threadId) {
+    if (threadDepth < PROFILER_MAX_DEPTH) {
+        ProfilerThreadEvent* event = &threadStack[threadDepth];
+        event->name = name;
+        event->threadId = threadId;
+        event->startNs = Utils_GetTimeNs();
+    }
+    threadDepth++;
+}
+
+static void Profiler_EndThreadZone(void) {
+    if (threadDepth == 0 || --threadDepth >= PROFILER_MAX_DEPTH) return;
+    
+    __atomic_fetch_add(&threadWriters, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&threadCapturing, __ATOMIC_SEQ_CST)) {
+        int index = __atomic_fetch_add(&threadEventCount, 1, __ATOMIC_RELAXED);
+        if (index < threadEventCapacity) {
+            threadEvents[index] = threadStack[threadDepth];
+            threadEvents[index].endNs = Utils_GetTimeNs();
+        }
+    }
+    __atomic_fetch_sub(&threadWriters, 1, __ATOMIC_RELEASE);
+}
+
+void Profiler_BeginZone(const char* name) {
+    unsigned long threadId = Utils_GetThreadId();
+    if (!frameStarted || threadId != mainThreadId) {
+        Profiler_BeginThreadZone(name, threadId);
+        return;
+    }
+    
+    // Past the maximum depth only the nesting level is tracked
+    if (depth >= PROFILER_MAX_DEPTH) {
+        depth++;
+        return;
+    }
+    
+    ProfilerFrame* frame = &frames[currentFrame];
+    ProfilerScope* scope = &stack[depth];
+    scope->zone = Profiler_FindZone(name);
+    scope->event = -1;
+    scope->childNs = 0;
+    
+    if (scope->zone >= 0 && frame->eventCount < PROFILER_MAX_EVENTS) {
+        scope->event = frame->eventCount++;
+        frame->events[scope->event].zone = scope->zone;
+        frame->events[scope->event].depth = depth;
+    }
+    
+    depth++;
+    scope->startNs = Utils_GetTimeNs();
+    if (scope->event >= 0) frame->events[scope->event].startNs = scope->startNs;
+}
+
+void Profiler_EndZone(void) {
+    if (threadDepth > 0 || Utils_GetThreadId() != mainThreadId) {
+        Profiler_EndThreadZone();
+        return;
+    }
+    if (!frameStarted || depth == 0) return;
+    
+    long long now = Utils_GetTimeNs();
+    if (--depth >= PROFILER_MAX_DEPTH) return;
+    
+    ProfilerFrame* frame = &frames[currentFrame];
+    ProfilerScope* scope = &stack[depth];
+    long long duration = now - scope->startNs;
+    
+    if (scope->zone >= 0) frame->zoneSelfNs[scope->zone] += duration - scope->childNs;
+    if (scope->event >= 0) frame->events[scope->event].endNs = now;
+    if (depth > 0) stack[depth - 1].childNs += duration;
+}
+
+void Profiler_Counter(const char* name, double value) {
+    if (!frameStarted || Utils_GetThreadId() != mainThreadId) return;
+    
+    ProfilerFrame* frame = &frames[currentFrame];
+    
+    // Repeated samples within a frame overwrite the earlier value
+    for (int i = 0; i < frame->counterCount; i++) {
+        if (frame->counters[i].name == name) {
+            frame->counters[i].value = value;
+            return;
+        }
+    }
+    if (frame->counterCount >= PROFILER_MAX_COUNTERS) return;
+    
+    frame->counters[frame->counterCount].name = name;
+    frame->counters[frame->counterCount].value = value;
+    frame->counterCount++;
+}
+
+// Stacked bars of per-zone self time for the recorded frames, newest on the right
+void Profiler_DrawGraph(int x, int y, int width, int height) {
+    const Color zoneColors[] = {
+        RED, ORANGE, GOLD, LIME, SKYBLUE, VIOLET, PINK, BEIGE,
+        GREEN, BLUE, PURPLE, MAROON, BROWN, DARKGREEN, DARKBLUE, MAGENTA
+    };
+    const double fullScaleNs = 2.0 * 1000000000.0 / DEFAULT_FPS;  // Two frame budgets
+    float barWidth = (float)width / PROFILER_HISTORY_FRAMES;
+    int colorCount = (int)(sizeof(zoneColors) / sizeof(zoneColors[0]));
+    
+    DrawRectangle(x, y, width, height, (Color){0, 0, 0, 160});
+    
+    for (int i = 0; i < completedFrames; i++) {
+        // Oldest completed frame first
+        int index = (currentFrame - completedFrames + i + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES;
+        const ProfilerFrame* frame = &frames[index];
+        float barX = x + width - (completedFrames - i) * barWidth;
+        float top = (float)(y + height);
+        
+        for (int zone = 0; zone < zoneCount; zone++) {
+            if (frame->zoneSelfNs[zone] <= 0) continue;
+            
+            float barHeight = (float)(frame->zoneSelfNs[zone] / fullScaleNs * height);
+            if (top - barHeight < y) barHeight = top - y;
+            top -= barHeight;
+            DrawRectangleRec((Rectangle){ barX, top, barWidth, barHeight }, zoneColors[zone % colorCount]);
+        }
+        
+        // Uninstrumented part of the frame
+        float restHeight = (float)((frame->endNs - frame->startNs) / fullScaleNs * height) - (y + height - top);
+        if (restHeight > 0.0f) {
+            if (top - restHeight < y) restHeight = top - y;
+            DrawRectangleRec((Rectangle){ barX, top - restHeight, barWidth, restHeight }, DARKGRAY);
+        }
+    }
+    
+    // Frame budget line
+    DrawLine(x, y + height / 2, x + width, y + height / 2, (Color){255, 255, 255, 120});
+    DrawRectangleLines(x, y, width, height, GRAY);
+    Text_Draw(TextFormat("%.1fms", fullScaleNs / 2000000.0), x + 2, y + height / 2 - 9, 8, LIGHTGRAY);
+    
+    // Legend in two columns under the graph
+    int columnWidth = width / 2;
+    for (int zone = 0; zone < zoneCount; zone++) {
+        int legendX = x + (zone % 2) * columnWidth;
+        int legendY = y + height + 4 + (zone / 2) * 10;
+        DrawRectangle(legendX, legendY + 1, 6, 6, zoneColors[zone % colorCount]);
+        Text_Draw(zoneNames[zone], legendX + 9, legendY, 8, LIGHTGRAY);
+    }
+}
+
+// Mean self time per zone over the recorded history, for text reports
+int Profiler_GetZoneAverages(const char** names, double* averageMs, int maxZones) {
+    int count = zoneCount < maxZones ? zoneCount : maxZones;
+    
+    for (int zone = 0; zone < count; zone++) {
+        long long totalNs = 0;
+        for (int i = 0; i < completedFrames; i++) {
+            int index = (currentFrame - completedFrames + i + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES;
+            totalNs += frames[index].zoneSelfNs[zone];
+        }
+        names[zone] = zoneNames[zone];
+        averageMs[zone] = completedFrames > 0 ? totalNs / 1000000.0 / completedFrames : 0.0;
+    }
+    
+    return count;
+}
+
+// =====================================
+// Chrome Trace Capture
+// =====================================
+
+bool Profiler_StartCapture(int frameCount) {
+    if (captureFrames) return false;
+    
+    if (frameCount <= 0) frameCount = PROFILER_CAPTURE_FRAMES;
+    if (frameCount > PROFILER_MAX_CAPTURE_FRAMES) frameCount = PROFILER_MAX_CAPTURE_FRAMES;
+    
+    // Allocate everything up front so capturing doesn't touch the heap per frame
+    captureFrames = (ProfilerFrame*)malloc(sizeof(ProfilerFrame) * frameCount);
+    if (!captureFrames) {
+        TraceLog(LOG_WARNING, "Profiler: could not allocate a %d frame capture", frameCount);
+        return false;
+    }
+    
+    // Worker zones are optional: without a buffer the trace just lacks them
+    threadEvents = (ProfilerThreadEvent*)malloc(sizeof(ProfilerThreadEvent) * frameCount * PROFILER_THREAD_EVENTS_PER_FRAME);
+    threadEventCapacity = threadEvents ? frameCount * PROFILER_THREAD_EVENTS_PER_FRAME : 0;
+    __atomic_store_n(&threadEventCount, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&threadCapturing, threadEvents != NULL, __ATOMIC_SEQ_CST);
+    
+    captureCapacity = frameCount;
+    captureCount = 0;
+    TraceLog(LOG_INFO, "Profiler: capturing %d frames", frameCount);
+    return true;
+}
+
+// Trace event timestamps are microseconds relative to the capture start
+static void Profiler_WriteTrace(const char* fileName) {
+    FILE* file = fopen(fileName, "w");
+    if (!file) {
+        TraceLog(LOG_WARNING, "Profiler: could not open %s", fileName);
+        return;
+    }
+    
+    long long originNs = captureFrames[0].startNs;
+    
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"engine\":\"%s %s\",\"build\":\"%s\"},\"traceEvents\":[\n",
+            ENGINE_NAME, ENGINE_VERSION, BUILD_ID);
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}},\n",
+            mainThreadId, ENGINE_NAME);
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"main\"}}",
+            mainThreadId);
+    
+    for (int f = 0; f < captureCount; f++) {
+        const ProfilerFrame* frame = &captureFrames[f];
+        double frameStart = (frame->startNs - originNs) / 1000.0;
+        
+        fprintf(file, ",\n{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%lu,\"args\":{\"frame\":%d}}",
+                frameStart, (frame->endNs - frame->startNs) / 1000.0, mainThreadId, f);
+        
+        for (int i = 0; i < frame->eventCount; i++) {
+            const ProfilerEvent* event = &frame->events[i];
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%lu}",
+                    zoneNames[event->zone], (event->startNs - originNs) / 1000.0,
+                    (event->endNs - event->startNs) / 1000.0, mainThreadId);
+        }
+        
+        for (int i = 0; i < frame->counterCount; i++) {
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu,\"args\":{\"value\":%g}}",
+                    frame->counters[i].name, frameStart, mainThreadId, frame->counters[i].value);
+        }
+    }
+    
+    // Worker zones carry their own thread IDs; skip any that began before the capture
+    int threadCount = __atomic_load_n(&threadEventCount, __ATOMIC_RELAXED);
+    if (threadCount > threadEventCapacity) threadCount = threadEventCapacity;
+    for (int i = 0; i < threadCount; i++) {
+        const ProfilerThreadEvent* event = &threadEvents[i];
+        if (event->startNs < originNs) continue;
+        fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%lu}",
+                event->name, (event->startNs - originNs) / 1000.0,
+                (event->endNs - event->startNs) / 1000.0, event->threadId);
+    }
+    
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    
+    TraceLog(LOG_INFO, "Profiler: wrote %d frames to %s", captureCount, fileName);
+}
+
+void Profiler_StopCapture(void) {
+    if (!captureFrames) return;
+    
+    // Let worker threads finish any zone they are writing before reading the buffer
+    __atomic_store_n(&threadCapturing, 0, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&threadWriters, __ATOMIC_SEQ_CST) > 0) {
+        // Spin
+    }
+    
+    if (captureCount > 0) {
+        char fileName[64];
+        snprintf(fileName, sizeof(fileName), "trace_%ld.json", (long)time(NULL));
+        Profiler_WriteTrace(fileName);
+    }
+    
+    free(captureFrames);
+    captureFrames = NULL;
+    captureCapacity = 0;
+    captureCount = 0;
+    free(threadEvents);
+    threadEvents = NULL;
+    threadEventCapacity = 0;
+}
+
+bool Profiler_IsCapturing(void) {
+    return captureFrames != NULL;
+}
+
+int Profiler_GetCapturedFrames(void) {
+    return captureCount;
+}
+
+void Profiler_Shutdown(void) {
+    // Keep whatever was captured if the game closes mid-capture
+    Profiler_StopCapture();
+}
+
+#endif // PROFILER_ENABLED
@@ -1,5 +1,9 @@
 #include "engine.h"
+#include <rlgl.h>
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
 
 // =====================================
 // Rendering Utilities Implementation
@@ -24,48 +28,156 @@ void Render_SelectionBox(Vector2 start, Vector2 end) {
 void Render_DebugInfo(EngineState* engine) {
     if (!engine) return;
     
+    // Values that change every frame keep their own retained layout
+    static TextField fpsField;
+    static TextField deltaField;
+    static TextField uiTimeField;
+    static TextField pacingField;
+    static TextField metricFields[TELEMETRY_METRIC_COUNT];
+    static TextField cacheField;
+    static TextField drawsField;
+    static TextField zoneFields[RENDER_STATS_MAX_ZONES];
+    static TextField recordingField;
+    static TextField idleField;
+    static TextField entitiesField;
+    static TextField selectedField;
+    static TextField groupFields[MAX_CONTROL_GROUPS];
+#ifdef PROFILER_ENABLED
+    static TextField captureField;
+#endif
+    
     int y = 5;
     int lineHeight = 12;
     Color textColor = LIGHTGRAY;
     int fontSize = 8;
     
     // Engine info
-    DrawText(ENGINE_NAME, 5, y, fontSize + 2, WHITE);
+    Text_Draw(ENGINE_NAME, 5, y, fontSize + 2, WHITE);
     y += lineHeight + 3;
     
-    DrawText(TextFormat("FPS: %d", GetFPS()), 5, y, fontSize, textColor);
+    Text_DrawLayout(Text_LayoutInt(&fpsField, "FPS: %d", GetFPS(), fontSize), 5, y, textColor);
+    y += lineHeight;
+    
+    Text_DrawLayout(Text_LayoutFloat(&deltaField, "Delta: %.3fms", engine->deltaTime * 1000.0f, fontSize), 5, y, textColor);
+    y += lineHeight;
+    
+    // Multi-value lines are only formatted again when one of their values moves
+    double pacingKeys[] = { engine->pacingMode, engine->lateLatch, llround(engine->pacingWorkNs / 10000.0) };
+    if (Text_FieldChanged(&pacingField, pacingKeys, 3, fontSize)) {
+        Text_LayoutString(&pacingField, TextFormat("Pacing: %s%s, predicted work %.2fms",
+                Engine_GetPacingName(engine->pacingMode), engine->lateLatch ? " + late latch" : "",
+                engine->pacingWorkNs / 1000000.0), fontSize);
+    }
+    Text_DrawLayout(&pacingField.layout, 5, y, textColor);
+    y += lineHeight;
+    
+    // Frame time percentiles since startup (hitches show up in p99/max, not FPS)
+    for (int metric = 0; metric < TELEMETRY_METRIC_COUNT; metric++) {
+        if (metric >= TELEMETRY_INPUT_TO_UPDATE && !engine->measureLatency) break;
+        
+        TelemetrySummary summary;
+        Telemetry_GetSummary((TelemetryMetric)metric, &summary);
+        double metricKeys[] = { summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs, (double)summary.overBudget };
+        if (Text_FieldChanged(&metricFields[metric], metricKeys, 5, fontSize)) {
+            Text_LayoutString(&metricFields[metric], TextFormat("%s: p50 %.2f p95 %.2f p99 %.2f max %.2fms (%lld over)",
+                    Telemetry_GetMetricName((TelemetryMetric)metric), summary.p50Ms, summary.p95Ms,
+                    summary.p99Ms, summary.maxMs, summary.overBudget), fontSize);
+        }
+        Text_DrawLayout(&metricFields[metric].layout, 5, y, summary.overBudget > 0 ? ORANGE : textColor);
+        y += lineHeight;
+    }
+    
+    // UI build cost and text cache activity
+    Text_DrawLayout(Text_LayoutFloat(&uiTimeField, "UI CPU: %.3fms", engine->uiCpuTime * 1000.0f, fontSize), 5, y, textColor);
     y += lineHeight;
     
-    DrawText(TextFormat("Delta: %.3fms", engine->deltaTime * 1000.0f), 5, y, fontSize, textColor);
+    int cachedLayouts = 0;
+    int newLayouts = 0;
+    Text_GetStats(&cachedLayouts, &newLayouts);
+    double cacheKeys[] = { cachedLayouts, newLayouts };
+    if (Text_FieldChanged(&cacheField, cacheKeys, 2, fontSize)) {
+        Text_LayoutString(&cacheField, TextFormat("Text cache: %d layouts (%d new)", cachedLayouts, newLayouts), fontSize);
+    }
+    Text_DrawLayout(&cacheField.layout, 5, y, textColor);
     y += lineHeight;
     
+    // Draw submissions from the previous frame, per zone (* = flushed mid-zone)
+    const RenderFrameStats* rs = &engine->lastRenderStats;
+    double drawsKeys[] = { rs->drawCalls, rs->vertices, rs->flushes, rs->forcedFlushes, rs->textureSwitches, rs->targetSwitches };
+    if (Text_FieldChanged(&drawsField, drawsKeys, 6, fontSize)) {
+        Text_LayoutString(&drawsField, TextFormat("Draws: %d | Verts: %d | Flushes: %d (+%d zone) | Tex: %d | RT: %d",
+                rs->drawCalls, rs->vertices, rs->flushes, rs->forcedFlushes, rs->textureSwitches, rs->targetSwitches), fontSize);
+    }
+    Text_DrawLayout(&drawsField.layout, 5, y, textColor);
+    y += lineHeight;
+    for (int i = 0; i < rs->zoneCount; i++) {
+        const RenderZoneStats* zone = &rs->zones[i];
+        // Zone names are string literals, so the pointer identifies the name
+        double zoneKeys[] = { (double)(size_t)zone->name, zone->partial, zone->drawCalls, zone->vertices, zone->flushes };
+        if (Text_FieldChanged(&zoneFields[i], zoneKeys, 5, fontSize)) {
+            Text_LayoutString(&zoneFields[i], TextFormat("  %s%s: %d draws, %d verts, %d flushes", zone->name,
+                    zone->partial ? "*" : "", zone->drawCalls, zone->vertices, zone->flushes), fontSize);
+        }
+        Text_DrawLayout(&zoneFields[i].layout, 5, y, DARKGRAY);
+        y += lineHeight;
+    }
+    if (engine->renderStatsRecording) {
+        Text_DrawLayout(Text_LayoutInt(&recordingField, "F7: Recording stats CSV (%d frames)",
+                engine->renderStatsFrame, fontSize), 5, y, RED);
+    } else {
+        Text_Draw("F7: Record stats CSV", 5, y, fontSize, DARKGRAY);
+    }
+    y += lineHeight;
+    Text_Draw(engine->measureLatency ? "F9: Measuring input latency" : "F9: Measure input latency",
+            5, y, fontSize, engine->measureLatency ? RED : DARKGRAY);
+    y += lineHeight;
+    
+    // On-demand rendering state
+    if (engine->idle) {
+        Text_DrawLayout(Text_LayoutInt(&idleField, "Idle: %d frames skipped", engine->idleSkippedFrames, fontSize),
+                5, y, GREEN);
+        y += lineHeight;
+    }
+    
     // Resolution mode
     if (engine->useInternalResolution) {
-        DrawText(TextFormat("Resolution: %dx%d (Internal)", engine->internalWidth, engine->internalHeight), 5, y, fontSize, YELLOW);
+        Text_Draw(TextFormat("Resolution: %dx%d (Internal)", engine->internalWidth, engine->internalHeight), 5, y, fontSize, YELLOW);
+        y += lineHeight;
+        Text_Draw(TextFormat("3D Scene: %dx%d (%d%%, F6 to cycle)", (int)engine->sourceRect.width,
+                (int)engine->sourceRect.height, (int)(engine->sceneScale * 100.0f + 0.5f)), 5, y, fontSize, YELLOW);
     } else {
-        DrawText(TextFormat("Resolution: %dx%d (Native)", engine->windowWidth, engine->windowHeight), 5, y, fontSize, textColor);
+        Text_Draw(TextFormat("Resolution: %dx%d (Native)", engine->windowWidth, engine->windowHeight), 5, y, fontSize, textColor);
     }
     y += lineHeight;
     
     // Fullscreen status
-    DrawText(TextFormat("Window: %dx%d (%s)", engine->windowWidth, engine->windowHeight, 
+    Text_Draw(TextFormat("Window: %dx%d (%s)", engine->windowWidth, engine->windowHeight, 
             IsWindowFullscreen() ? "Fullscreen" : "Windowed"), 5, y, fontSize, textColor);
     y += lineHeight;
     
-    DrawText("F1: Toggle resolution | F11/Alt+Enter: Fullscreen", 5, y, fontSize, DARKGRAY);
+    Text_Draw("F1: Toggle resolution | F11/Alt+Enter: Fullscreen", 5, y, fontSize, DARKGRAY);
     y += lineHeight;
     
     // Aspect ratio mode
-    DrawText(TextFormat("Aspect: %s (F3 to toggle)", 
+    Text_Draw(TextFormat("Aspect: %s (F3 to toggle)", 
             engine->maintainAspectRatio ? "Maintain 16:9" : "Stretch to Fill"), 
             5, y, fontSize, engine->maintainAspectRatio ? LIME : YELLOW);
     y += lineHeight;
     
     // Scanline effect status (only show when using internal resolution)
     if (engine->useInternalResolution) {
-        DrawText(TextFormat("Scanlines: %s (F2 to toggle)", engine->showScanlines ? "ON" : "OFF"), 
+        Text_Draw(TextFormat("Scanlines: %s (F2 to toggle)", engine->showScanlines ? "ON" : "OFF"), 
                 5, y, fontSize, engine->showScanlines ? GREEN : DARKGRAY);
         y += lineHeight;
+        
+        if (engine->crtShaderReady) {
+            Text_Draw(TextFormat("Curvature: %s (F4) | Vignette: %s (F5)",
+                    engine->showCurvature ? "ON" : "OFF", engine->showVignette ? "ON" : "OFF"),
+                    5, y, fontSize, (engine->showCurvature || engine->showVignette) ? GREEN : DARKGRAY);
+        } else {
+            Text_Draw("CRT shader unavailable (texture scanlines)", 5, y, fontSize, DARKGRAY);
+        }
+        y += lineHeight;
     }
     
     // Camera info
@@ -76,16 +188,20 @@ void Render_DebugInfo(EngineState* engine) {
         case VIEW_MODE_FIRST_PERSON: modeStr = "FIRST PERSON"; break;
         case VIEW_MODE_THIRD_PERSON: modeStr = "THIRD PERSON"; break;
     }
-    DrawText(TextFormat("Camera: %s", modeStr), 10, y, fontSize, textColor);
+    Text_Draw(TextFormat("Camera: %s", modeStr), 10, y, fontSize, textColor);
     y += lineHeight;
     
     // Entity info
-    DrawText(TextFormat("Entities: %d/%d", engine->entityCount, MAX_ENTITIES), 5, y, fontSize, textColor);
+    double entitiesKeys[] = { engine->entityCount };
+    if (Text_FieldChanged(&entitiesField, entitiesKeys, 1, fontSize)) {
+        Text_LayoutString(&entitiesField, TextFormat("Entities: %d/%d", engine->entityCount, MAX_ENTITIES), fontSize);
+    }
+    Text_DrawLayout(&entitiesField.layout, 5, y, textColor);
     y += lineHeight;
     
     int selectedCount = Entity_GetSelectedCount(engine);
     if (selectedCount > 0) {
-        DrawText(TextFormat("Selected: %d", selectedCount), 5, y, fontSize, LIME);
+        Text_DrawLayout(Text_LayoutInt(&selectedField, "Selected: %d", selectedCount, fontSize), 5, y, LIME);
         y += lineHeight;
     }
     
@@ -95,31 +211,402 @@ void Render_DebugInfo(EngineState* engine) {
     for (int i = 1; i < MAX_CONTROL_GROUPS; i++) {
         if (engine->controlGroups[i].active && engine->controlGroups[i].entityCount > 0) {
             if (!hasGroups) {
-                DrawText("Groups:", 5, y, fontSize, textColor);
+                Text_Draw("Groups:", 5, y, fontSize, textColor);
                 y += lineHeight;
                 hasGroups = true;
             }
-            DrawText(TextFormat("  [%d]: %d units", i, engine->controlGroups[i].entityCount), 
-                    5, y, fontSize, SKYBLUE);
+            double groupKeys[] = { engine->controlGroups[i].entityCount };
+            if (Text_FieldChanged(&groupFields[i], groupKeys, 1, fontSize)) {
+                Text_LayoutString(&groupFields[i], TextFormat("  [%d]: %d units", i,
+                        engine->controlGroups[i].entityCount), fontSize);
+            }
+            Text_DrawLayout(&groupFields[i].layout, 5, y, SKYBLUE);
             y += lineHeight;
         }
     }
     
+#ifdef PROFILER_ENABLED
+    // Per-zone frame time history in the top right corner
+    Profiler_DrawGraph(Engine_GetUIWidth(engine) - PROFILER_HISTORY_FRAMES - 5, 5, PROFILER_HISTORY_FRAMES, 80);
+    
+    if (Profiler_IsCapturing()) {
+        Text_DrawLayout(Text_LayoutInt(&captureField, "F8: Capturing trace (%d frames)",
+                Profiler_GetCapturedFrames(), fontSize), 5, y, RED);
+    } else {
+        Text_Draw("F8: Capture trace", 5, y, fontSize, DARKGRAY);
+    }
+    y += lineHeight;
+#endif
+    
     // Controls hint
-    y = (engine->useInternalResolution ? engine->internalHeight : engine->windowHeight) - 50;
+    y = Engine_GetUIHeight(engine) - 50;
     if (engine->activeGamepad >= 0) {
-        DrawText("Gamepad Camera: L-Stick/D-Pad: Move | R-Stick: Rotate | LB/LT/L3/R3: Zoom", 5, y, fontSize, DARKGRAY);
+        Text_Draw("Gamepad Camera: L-Stick/D-Pad: Move | R-Stick: Rotate | LB/LT/L3/R3: Zoom", 5, y, fontSize, DARKGRAY);
         y += lineHeight;
-        DrawText("Select: Reset | Y: Switch Camera | Start: Pause", 5, y, fontSize, DARKGRAY);
+        Text_Draw("Select: Reset | Y: Switch Camera | Start: Pause", 5, y, fontSize, DARKGRAY);
     } else {
-        DrawText("TAB: Switch Camera | WASD: Move | Mouse Wheel: Zoom", 5, y, fontSize, DARKGRAY);
+        Text_Draw("TAB: Switch Camera | WASD: Move | Mouse Wheel: Zoom", 5, y, fontSize, DARKGRAY);
         y += lineHeight;
-        DrawText("I: Info | ESC: Exit", 5, y, fontSize, DARKGRAY);
+        Text_Draw("I: Info | ESC: Exit", 5, y, fontSize, DARKGRAY);
     }
     y += lineHeight;
     
     // Show gamepad connection status
     if (engine->activeGamepad >= 0) {
-        DrawText(TextFormat("Gamepad %d Connected", engine->activeGamepad + 1), 5, y, fontSize, GREEN);
+        Text_Draw(TextFormat("Gamepad %d Connected", engine->activeGamepad + 1), 5, y, fontSize, GREEN);
+    }
+}
+
+// =====================================
+// CRT Post-Processing
+// =====================================
+
+// GLSL prologues for the supported GL versions. The shader body below is
+// written against these macros so one source covers desktop GL and GLES.
+static const char* crtHeaderGL33 =
+    "#version 330\n"
+    "#define IN in\n"
+    "#define TEXTURE texture\n"
+    "#define OUT_COLOR finalColor\n"
+    "out vec4 finalColor;\n";
+
+static const char* crtHeaderGL21 =
+    "#version 120\n"
+    "#define IN varying\n"
+    "#define TEXTURE texture2D\n"
+    "#define OUT_COLOR gl_FragColor\n";
+
+static const char* crtHeaderES20 =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "#define IN varying\n"
+    "#define TEXTURE texture2D\n"
+    "#define OUT_COLOR gl_FragColor\n";
+
+// Scanlines, barrel curvature and vignette in a single fullscreen pass
+static const char* crtFragmentBody =
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 outputSize;\n"
+    "uniform float scanlines;\n"
+    "uniform float curvature;\n"
+    "uniform float vignette;\n"
+    "void main() {\n"
+    "    vec2 uv = fragTexCoord;\n"
+    "    if (curvature > 0.0) {\n"
+    "        vec2 c = uv * 2.0 - 1.0;\n"
+    "        c *= 1.0 + curvature * dot(c, c);\n"
+    "        uv = c * 0.5 + 0.5;\n"
+    "        if (uv.x < 0.0 || uv.x > 1.0 || uv.y < 0.0 || uv.y > 1.0) {\n"
+    "            OUT_COLOR = vec4(0.0, 0.0, 0.0, 1.0);\n"
+    "            return;\n"
+    "        }\n"
+    "    }\n"
+    "    vec4 color = TEXTURE(texture0, uv) * colDiffuse * fragColor;\n"
+    "    float line = mod(floor(uv.y * outputSize.y), 2.0);\n"
+    "    color.rgb *= 1.0 - scanlines * (1.0 - line);\n"
+    "    vec2 v = uv * (1.0 - uv);\n"
+    "    float shade = clamp(pow(v.x * v.y * 16.0, 0.25), 0.0, 1.0);\n"
+    "    color.rgb *= mix(1.0, shade, vignette);\n"
+    "    OUT_COLOR = color;\n"
+    "}\n";
+
+void Render_InitPostProcess(EngineState* engine) {
+    if (!engine) return;
+
+    engine->crtShaderReady = false;
+
+    // Pick the GLSL dialect for the current context (GL 1.1 has no shaders)
+    const char* header = NULL;
+    switch (rlGetVersion()) {
+        case RL_OPENGL_33:
+        case RL_OPENGL_43:
+            header = crtHeaderGL33;
+            break;
+        case RL_OPENGL_21:
+            header = crtHeaderGL21;
+            break;
+        case RL_OPENGL_ES_20:
+        case RL_OPENGL_ES_30:
+            header = crtHeaderES20;
+            break;
+        default:
+            break;
+    }
+
+    if (header) {
+        char source[2048];
+        snprintf(source, sizeof(source), "%s%s", header, crtFragmentBody);
+
+        // NULL vertex shader selects raylib's default one
+        engine->crtShader = LoadShaderFromMemory(NULL, source);
+        engine->crtShaderReady = IsShaderValid(engine->crtShader) &&
+                                 engine->crtShader.id != rlGetShaderIdDefault();
+    }
+
+    if (engine->crtShaderReady) {
+        engine->crtOutputSizeLoc = GetShaderLocation(engine->crtShader, "outputSize");
+        engine->crtScanlinesLoc = GetShaderLocation(engine->crtShader, "scanlines");
+        engine->crtCurvatureLoc = GetShaderLocation(engine->crtShader, "curvature");
+        engine->crtVignetteLoc = GetShaderLocation(engine->crtShader, "vignette");
+    } else {
+        TraceLog(LOG_WARNING, "CRT shader unavailable, using texture scanlines only");
+    }
+
+    // Fallback scanlines: a dark row over a clear row, tiled across the
+    // screen with a single textured quad
+    Image tile = GenImageColor(1, 2, BLANK);
+    ImageDrawPixel(&tile, 0, 0, (Color){0, 0, 0, CRT_SCANLINE_ALPHA});
+    engine->scanlineTexture = LoadTextureFromImage(tile);
+    UnloadImage(tile);
+    SetTextureFilter(engine->scanlineTexture, TEXTURE_FILTER_POINT);
+    SetTextureWrap(engine->scanlineTexture, TEXTURE_WRAP_REPEAT);
+}
+
+void Render_UnloadPostProcess(EngineState* engine) {
+    if (!engine) return;
+
+    if (engine->crtShaderReady) {
+        UnloadShader(engine->crtShader);
+        engine->crtShaderReady = false;
+    }
+    UnloadTexture(engine->scanlineTexture);
+}
+
+// Draw the internal render texture to the screen, applying the enabled CRT
+// effects as part of the same upscale
+void Render_PresentTarget(EngineState* engine) {
+    if (!engine) return;
+
+    // Flip Y coordinate for correct orientation
+    Rectangle flippedSource = { 0, 0, engine->sourceRect.width, -engine->sourceRect.height };
+
+    bool useShader = engine->crtShaderReady &&
+                     (engine->showScanlines || engine->showCurvature || engine->showVignette);
+
+    if (useShader) {
+        Vector2 outputSize = { engine->destRect.width, engine->destRect.height };
+        float scanlines = engine->showScanlines ? CRT_SCANLINE_ALPHA / 255.0f : 0.0f;
+        float curvature = engine->showCurvature ? CRT_CURVATURE_AMOUNT : 0.0f;
+        float vignette = engine->showVignette ? 1.0f : 0.0f;
+
+        SetShaderValue(engine->crtShader, engine->crtOutputSizeLoc, &outputSize, SHADER_UNIFORM_VEC2);
+        SetShaderValue(engine->crtShader, engine->crtScanlinesLoc, &scanlines, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(engine->crtShader, engine->crtCurvatureLoc, &curvature, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(engine->crtShader, engine->crtVignetteLoc, &vignette, SHADER_UNIFORM_FLOAT);
+
+        BeginShaderMode(engine->crtShader);
+        DrawTexturePro(engine->renderTarget.texture, flippedSource, engine->destRect,
+                      (Vector2){0, 0}, 0.0f, WHITE);
+        EndShaderMode();
+        return;
+    }
+
+    DrawTexturePro(engine->renderTarget.texture, flippedSource, engine->destRect,
+                  (Vector2){0, 0}, 0.0f, WHITE);
+
+    // Shaderless scanlines: one repeating quad instead of a rectangle per line
+    if (engine->showScanlines) {
+        Rectangle tileSource = { 0, 0, 1, engine->destRect.height };
+        DrawTexturePro(engine->scanlineTexture, tileSource, engine->destRect,
+                      (Vector2){0, 0}, 0.0f, WHITE);
+    }
+}
+
+// =====================================
+// Render Statistics
+// =====================================
+
+// rlgl gives no submission hooks, so while stats are on we draw through our
+// own batch and read its draw call list at zone boundaries. Each zone ends
+// with a flush so the next one starts from an empty batch.
+#define RENDER_STATS_SENTINEL 0xFFFFFFFFu
+
+static rlRenderBatch statsBatch;
+static bool statsBatchLoaded = false;
+static bool statsBatchActive = false;
+static FILE* statsFile = NULL;
+
+// Add the batch's pending draw calls to a zone; returns false if it was empty
+static bool Render_StatsCollect(EngineState* engine, RenderZoneStats* zone) {
+    bool drew = false;
+    
+    for (int i = 0; i < statsBatch.drawCounter; i++) {
+        const rlDrawCall* draw = &statsBatch.draws[i];
+        if (draw->vertexCount <= 0) continue;
+        
+        zone->drawCalls++;
+        zone->vertices += draw->vertexCount;
+        if (draw->textureId != engine->renderStats.lastTextureId) {
+            zone->textureSwitches++;
+            engine->renderStats.lastTextureId = draw->textureId;
+        }
+        drew = true;
+    }
+    
+    return drew;
+}
+
+void Render_StatsBeginFrame(EngineState* engine) {
+    if (!engine) return;
+    
+    // Only pay for the extra flushes while someone is looking at the numbers
+    bool enabled = engine->showDebugInfo || engine->renderStatsRecording;
+#ifdef PROFILER_ENABLED
+    enabled = enabled || Profiler_IsCapturing();
+#endif
+    if (enabled && !statsBatchActive) {
+        if (!statsBatchLoaded) {
+            statsBatch = rlLoadRenderBatch(RENDER_STATS_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+            statsBatchLoaded = true;
+        }
+        rlSetRenderBatchActive(&statsBatch);
+        statsBatchActive = true;
+    } else if (!enabled && statsBatchActive) {
+        rlSetRenderBatchActive(NULL);  // Back to raylib's default batch
+        statsBatchActive = false;
+    }
+    
+    memset(&engine->renderStats, 0, sizeof(engine->renderStats));
+    engine->renderStats.activeZone = -1;
+}
+
+void Render_StatsBeginZone(EngineState* engine, const char* name) {
+    if (!engine || !statsBatchActive) return;
+    
+    RenderFrameStats* stats = &engine->renderStats;
+    if (stats->activeZone >= 0) Render_StatsEndZone(engine);
+    
+    // Submit anything drawn outside of a zone so it isn't attributed here
+    if (statsBatch.drawCounter > 1 || statsBatch.draws[0].vertexCount > 0) stats->forcedFlushes++;
+    rlDrawRenderBatchActive();
+    
+    // Zones with the same name accumulate within a frame
+    int index = 0;
+    while (index < stats->zoneCount && strcmp(stats->zones[index].name, name) != 0) index++;
+    if (index == stats->zoneCount) {
+        if (stats->zoneCount >= RENDER_STATS_MAX_ZONES) return;
+        stats->zones[stats->zoneCount++].name = name;
+    }
+    
+    // The last draw slot is never filled before rlgl flushes, so the sentinel
+    // only disappears if the batch is flushed inside this zone
+    stats->activeZone = index;
+    stats->startBuffer = statsBatch.currentBuffer;
+    statsBatch.draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].textureId = RENDER_STATS_SENTINEL;
+}
+
+void Render_StatsEndZone(EngineState* engine) {
+    if (!engine || !statsBatchActive || engine->renderStats.activeZone < 0) return;
+    
+    RenderFrameStats* stats = &engine->renderStats;
+    RenderZoneStats* zone = &stats->zones[stats->activeZone];
+    
+    // Each flush advances the batch to its next vertex buffer
+    int flushed = (statsBatch.currentBuffer - stats->startBuffer + RENDER_STATS_BATCH_BUFFERS) % RENDER_STATS_BATCH_BUFFERS;
+    if (flushed == 0 && statsBatch.draws[RL_DEFAULT_BATCH_DRAWCALLS - 1].textureId != RENDER_STATS_SENTINEL) {
+        flushed = RENDER_STATS_BATCH_BUFFERS;
+    }
+    if (flushed > 0) {
+        // Draw calls submitted by those flushes were not seen
+        zone->flushes += flushed;
+        zone->partial = true;
     }
-}
\ No newline at end of file
+    
+    // Submitting here splits the batch at the zone boundary; counted apart
+    // from the renderer's own flushes, which the sentinel detects above
+    if (Render_StatsCollect(engine, zone)) {
+        zone->forcedFlushes++;
+        rlDrawRenderBatchActive();
+    }
+    
+    stats->activeZone = -1;
+}
+
+void Render_StatsTargetSwitch(EngineState* engine) {
+    if (!engine) return;
+    engine->renderStats.targetSwitches++;
+}
+
+void Render_StatsEndFrame(EngineState* engine) {
+    if (!engine) return;
+    
+    RenderFrameStats* stats = &engine->renderStats;
+    if (stats->activeZone >= 0) Render_StatsEndZone(engine);
+    
+    for (int i = 0; i < stats->zoneCount; i++) {
+        stats->drawCalls += stats->zones[i].drawCalls;
+        stats->vertices += stats->zones[i].vertices;
+        stats->flushes += stats->zones[i].flushes;
+        stats->forcedFlushes += stats->zones[i].forcedFlushes;
+        stats->textureSwitches += stats->zones[i].textureSwitches;
+    }
+    
+    if (engine->renderStatsRecording && statsFile) {
+        int frame = engine->renderStatsFrame++;
+        for (int i = 0; i < stats->zoneCount; i++) {
+            const RenderZoneStats* zone = &stats->zones[i];
+            fprintf(statsFile, "%d,%s,%d,%d,%d,%d,%d,,%d\n", frame, zone->name, zone->drawCalls,
+                    zone->vertices, zone->flushes, zone->forcedFlushes, zone->textureSwitches,
+                    zone->partial ? 1 : 0);
+        }
+        fprintf(statsFile, "%d,total,%d,%d,%d,%d,%d,%d,\n", frame, stats->drawCalls, stats->vertices,
+                stats->flushes, stats->forcedFlushes, stats->textureSwitches, stats->targetSwitches);
+    }
+    
+    PROFILE_COUNTER("draw_calls", stats->drawCalls);
+    PROFILE_COUNTER("vertices", stats->vertices);
+    PROFILE_COUNTER("batch_flushes", stats->flushes);
+    PROFILE_COUNTER("zone_flushes", stats->forcedFlushes);
+    PROFILE_COUNTER("texture_switches", stats->textureSwitches);
+    PROFILE_COUNTER("target_switches", stats->targetSwitches);
+    
+    engine->lastRenderStats = *stats;
+}
+
+void Render_StatsToggleRecording(EngineState* engine) {
+    if (!engine) return;
+    
+    if (engine->renderStatsRecording) {
+        if (statsFile) fclose(statsFile);
+        statsFile = NULL;
+        engine->renderStatsRecording = false;
+        TraceLog(LOG_INFO, "Render stats: recorded %d frames", engine->renderStatsFrame);
+        return;
+    }
+    
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "render_stats_%ld.csv", (long)time(NULL));
+    statsFile = fopen(fileName, "w");
+    if (!statsFile) {
+        TraceLog(LOG_WARNING, "Render stats: could not open %s", fileName);
+        return;
+    }
+    
+    // Header identifies the build and settings so files can be compared across builds
+    fprintf(statsFile, "# %s %s, build %s (%s %s), internal %dx%d, scene %d%%\n",
+            ENGINE_NAME, ENGINE_VERSION, BUILD_ID, __DATE__, __TIME__,
+            engine->internalWidth, engine->internalHeight, (int)(engine->sceneScale * 100.0f + 0.5f));
+    fprintf(statsFile, "frame,zone,draw_calls,vertices,flushes,forced_flushes,texture_switches,target_switches,partial\n");
+    
+    engine->renderStatsRecording = true;
+    engine->renderStatsFrame = 0;
+    TraceLog(LOG_INFO, "Render stats: recording to %s", fileName);
+}
+
+void Render_UnloadStats(EngineState* engine) {
+    if (!engine) return;
+    
+    if (engine->renderStatsRecording) Render_StatsToggleRecording(engine);
+    
+    if (statsBatchActive) {
+        rlSetRenderBatchActive(NULL);
+        statsBatchActive = false;
+    }
+    if (statsBatchLoaded) {
+        rlUnloadRenderBatch(statsBatch);
+        statsBatchLoaded = false;
+    }
+}
@@ -0,0 +1,329 @@
+// mmap() is POSIX, not C99
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "engine.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =====================================
+// Sound Synthesis Implementation
+// =====================================
+
+// Samples are generated in blocks so every stage is a flat loop over
+// arrays that the compiler can vectorize
+#define SYNTH_BLOCK 256
+
+// Cycles added before wrapping the phase, keeping FM offsets positive
+#define SYNTH_PHASE_BIAS 64.0f
+
+int Synth_GetFrameCount(const SynthParams* params) {
+    if (!params || params->duration <= 0.0f) return 0;
+    return (int)(params->duration * AUDIO_SAMPLE_RATE);
+}
+
+// sin(2*pi*phase) for phase in [0, 1): parabolic approximation with one
+// refinement step, max error about 0.001 and no branches or table lookups
+static inline float Synth_Sine(float phase) {
+    float u = 2.0f * phase - 1.0f;
+    float y = 4.0f * u - 4.0f * u * fabsf(u);
+    y = 0.225f * (y * fabsf(y) - y) + y;
+    return -y;
+}
+
+// Branchless, so loops using it vectorize without -ffast-math
+static inline float Synth_Clamp01(float value) {
+    return 0.5f * (fabsf(value) - fabsf(value - 1.0f) + 1.0f);
+}
+
+void Synth_Render(const SynthParams* params, short* output) {
+    int frames = Synth_GetFrameCount(params);
+    float phase[SYNTH_BLOCK];
+    float wave[SYNTH_BLOCK];
+    float envelope[SYNTH_BLOCK];
+
+    // Linear frequency sweep: phase(t) = f0*t + (f1 - f0)/(2*T) * t^2 cycles
+    const float invRate = 1.0f / AUDIO_SAMPLE_RATE;
+    const float f0 = params->frequency;
+    const float sweep = (params->frequencyEnd - params->frequency) / (2.0f * params->duration);
+    const float fmDepth = params->fmIndex / (2.0f * PI);
+    const float attack = fmaxf(params->attack, invRate);
+    const float invAttack = 1.0f / attack;
+    const float invDecay = 1.0f / fmaxf(params->decay, invRate);
+    const float invRelease = 1.0f / fmaxf(params->release, invRate);
+    const float sustainDrop = 1.0f - params->sustain;
+    const float duration = params->duration;
+    const float amplitude = params->volume * 32767.0f;
+    unsigned int noise = Synth_Hash(params) | 1u;
+
+    for (int start = 0; start < frames; start += SYNTH_BLOCK) {
+        int count = (frames - start < SYNTH_BLOCK) ? frames - start : SYNTH_BLOCK;
+
+        // Carrier phase, optionally modulated by a sine at fmRatio times the carrier
+        for (int i = 0; i < count; i++) {
+            float t = (start + i) * invRate;
+            phase[i] = f0 * t + sweep * t * t;
+        }
+        if (params->fmIndex != 0.0f) {
+            for (int i = 0; i < count; i++) {
+                float modulator = params->fmRatio * phase[i];
+                modulator -= (float)(int)modulator;
+                phase[i] += fmDepth * Synth_Sine(modulator);
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            float p = phase[i] + SYNTH_PHASE_BIAS;
+            phase[i] = p - (float)(int)p;
+        }
+
+        // Oscillator
+        switch (params->waveform) {
+            case SYNTH_WAVE_SINE:
+                for (int i = 0; i < count; i++) wave[i] = Synth_Sine(phase[i]);
+                break;
+            case SYNTH_WAVE_SQUARE:
+                for (int i = 0; i < count; i++) wave[i] = (phase[i] < 0.5f) ? 1.0f : -1.0f;
+                break;
+            case SYNTH_WAVE_TRIANGLE:
+                for (int i = 0; i < count; i++) wave[i] = 4.0f * fabsf(phase[i] - 0.5f) - 1.0f;
+                break;
+            case SYNTH_WAVE_SAW:
+                for (int i = 0; i < count; i++) wave[i] = 2.0f * phase[i] - 1.0f;
+                break;
+            case SYNTH_WAVE_NOISE:
+                // xorshift32; the only sequential stage
+                for (int i = 0; i < count; i++) {
+                    noise ^= noise << 13;
+                    noise ^= noise >> 17;
+                    noise ^= noise << 5;
+                    wave[i] = (float)(int)noise * (1.0f / 2147483648.0f);
+                }
+                break;
+            default:
+                memset(wave, 0, sizeof(float) * count);
+                break;
+        }
+
+        // ADSR: linear attack and decay to the sustain level, release at the end
+        for (int i = 0; i < count; i++) {
+            float t = (start + i) * invRate;
+            float a = Synth_Clamp01(t * invAttack);
+            float d = 1.0f - sustainDrop * Synth_Clamp01((t - attack) * invDecay);
+            float r = Synth_Clamp01((duration - t) * invRelease);
+            envelope[i] = a * d * r;
+        }
+
+        for (int i = 0; i < count; i++) {
+            output[start + i] = (short)(wave[i] * envelope[i] * amplitude);
+        }
+    }
+}
+
+// FNV-1a over every parameter; also the noise seed
+unsigned int Synth_Hash(const SynthParams* params) {
+    float fields[] = {
+        (float)params->waveform, params->frequency, params->frequencyEnd, params->duration,
+        params->attack, params->decay, params->sustain, params->release,
+        params->fmRatio, params->fmIndex, params->volume, (float)AUDIO_SAMPLE_RATE
+    };
+    const unsigned char* bytes = (const unsigned char*)fields;
+    unsigned int hash = 2166136261u ^ SYNTH_BANK_VERSION;
+
+    for (size_t i = 0; i < sizeof(fields); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// =====================================
+// Sound Bank Cache
+// =====================================
+
+// File layout: header, one entry per sound, then all samples back to back
+typedef struct {
+    char magic[4];
+    unsigned int version;
+    unsigned int count;
+    unsigned int totalFrames;
+} SynthBankHeader;
+
+typedef struct {
+    unsigned int hash;
+    unsigned int frameCount;
+    unsigned int offset;           // In samples from the start of the sample data
+    unsigned int reserved;
+} SynthBankEntry;
+
+static const short* bankSamples[AUDIO_MAX_SOUNDS];
+static int bankFrames[AUDIO_MAX_SOUNDS];
+static int bankCount = 0;
+
+// Backing memory: either the mapped file or a block of freshly rendered samples
+static void* bankFile = NULL;
+static size_t bankFileSize = 0;
+static bool bankMapped = false;
+static short* bankRendered = NULL;
+
+static void* Synth_MapFile(const char* path, size_t* size) {
+#if defined(_WIN32)
+    // Plain read on Windows; the file is small
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* data = (length > 0) ? malloc(length) : NULL;
+    if (data && fread(data, 1, length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = (size_t)length;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat info;
+    void* data = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) data = NULL;
+        *size = (size_t)info.st_size;
+    }
+    close(fd);
+    bankMapped = (data != NULL);
+    return data;
+#endif
+}
+
+static void Synth_UnmapFile(void) {
+    if (!bankFile) return;
+#if defined(_WIN32)
+    free(bankFile);
+#else
+    if (bankMapped) munmap(bankFile, bankFileSize);
+#endif
+    bankFile = NULL;
+    bankFileSize = 0;
+    bankMapped = false;
+}
+
+// Point every sound at the cached samples; fails if any sound is missing
+static bool Synth_UseCachedBank(const SynthParams* params, int count) {
+    if (bankFileSize < sizeof(SynthBankHeader)) return false;
+
+    const SynthBankHeader* header = (const SynthBankHeader*)bankFile;
+    size_t dataStart = sizeof(SynthBankHeader) + sizeof(SynthBankEntry) * (size_t)header->count;
+    if (memcmp(header->magic, "SILB", 4) != 0 || header->version != SYNTH_BANK_VERSION ||
+        dataStart + sizeof(short) * (size_t)header->totalFrames > bankFileSize) {
+        return false;
+    }
+
+    const SynthBankEntry* entries = (const SynthBankEntry*)(header + 1);
+    const short* samples = (const short*)((const char*)bankFile + dataStart);
+
+    for (int i = 0; i < count; i++) {
+        unsigned int hash = Synth_Hash(&params[i]);
+        int frames = Synth_GetFrameCount(&params[i]);
+        int found = -1;
+
+        for (unsigned int e = 0; e < header->count; e++) {
+            if (entries[e].hash == hash && entries[e].frameCount == (unsigned int)frames &&
+                entries[e].offset + entries[e].frameCount <= header->totalFrames) {
+                found = (int)e;
+                break;
+            }
+        }
+        if (found < 0) return false;
+
+        bankSamples[i] = samples + entries[found].offset;
+        bankFrames[i] = frames;
+    }
+
+    return true;
+}
+
+static void Synth_SaveBank(const SynthParams* params, int count, int totalFrames, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "Synth: could not write sound bank %s", path);
+        return;
+    }
+
+    SynthBankHeader header = { {'S', 'I', 'L', 'B'}, SYNTH_BANK_VERSION, (unsigned int)count, (unsigned int)totalFrames };
+    fwrite(&header, sizeof(header), 1, file);
+
+    for (int i = 0; i < count; i++) {
+        SynthBankEntry entry = {
+            Synth_Hash(&params[i]), (unsigned int)bankFrames[i],
+            (unsigned int)(bankSamples[i] - bankRendered), 0
+        };
+        fwrite(&entry, sizeof(entry), 1, file);
+    }
+    fwrite(bankRendered, sizeof(short), totalFrames, file);
+    fclose(file);
+}
+
+bool Synth_LoadBank(const SynthParams* params, int count, const char* cachePath) {
+    Synth_UnloadBank();
+    if (!params || count <= 0 || count > AUDIO_MAX_SOUNDS) return false;
+    bankCount = count;
+
+    if (cachePath) {
+        bankFile = Synth_MapFile(cachePath, &bankFileSize);
+        if (bankFile && Synth_UseCachedBank(params, count)) return true;
+        Synth_UnmapFile();
+    }
+
+    // Cache miss: render everything into one block and rewrite the cache
+    int totalFrames = 0;
+    for (int i = 0; i < count; i++) {
+        totalFrames += Synth_GetFrameCount(&params[i]);
+    }
+
+    bankRendered = (short*)malloc(sizeof(short) * (totalFrames > 0 ? totalFrames : 1));
+    if (!bankRendered) {
+        TraceLog(LOG_WARNING, "Synth: could not allocate %d frames", totalFrames);
+        bankCount = 0;
+        return false;
+    }
+
+    int offset = 0;
+    for (int i = 0; i < count; i++) {
+        bankSamples[i] = bankRendered + offset;
+        bankFrames[i] = Synth_GetFrameCount(&params[i]);
+        Synth_Render(&params[i], bankRendered + offset);
+        offset += bankFrames[i];
+    }
+
+    if (cachePath) Synth_SaveBank(params, count, totalFrames, cachePath);
+    return true;
+}
+
+const short* Synth_GetBankSamples(int index, int* frameCount) {
+    if (index < 0 || index >= bankCount) {
+        if (frameCount) *frameCount = 0;
+        return NULL;
+    }
+
+    if (frameCount) *frameCount = bankFrames[index];
+    return bankSamples[index];
+}
+
+void Synth_UnloadBank(void) {
+    Synth_UnmapFile();
+    free(bankRendered);
+    bankRendered = NULL;
+    bankCount = 0;
+}
@@ -0,0 +1,251 @@
+#include "engine.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// =====================================
+// Frame Time Telemetry Implementation
+// =====================================
+
+// Log-linear histogram of microsecond samples (HdrHistogram layout): values
+// below 2*SUB are exact, above that every power of two is split into SUB
+// linear buckets, so each bucket is within 1/SUB of the recorded value.
+#define TELEMETRY_SUB_BITS 5
+#define TELEMETRY_SUB_BUCKETS (1 << TELEMETRY_SUB_BITS)
+
+typedef struct {
+    unsigned int buckets[TELEMETRY_BUCKETS];
+    long long count;
+    long long overBudget;
+    long long totalUs;
+    long long maxUs;
+} TelemetryHistogram;
+
+static TelemetryHistogram histograms[TELEMETRY_METRIC_COUNT];
+
+static const char* metricNames[TELEMETRY_METRIC_COUNT] = {
+    "frame", "update", "render", "present_jitter", "input_to_update", "input_to_draw", "input_to_present"
+};
+
+// Only the per-frame timings have a budget; jitter and input latency span
+// several frames by nature, so 0 leaves them uncounted
+static const long long metricBudgetsUs[TELEMETRY_METRIC_COUNT] = {
+    TELEMETRY_FRAME_BUDGET_US, TELEMETRY_FRAME_BUDGET_US, TELEMETRY_FRAME_BUDGET_US, 0, 0, 0, 0
+};
+
+static int Telemetry_BucketIndex(long long us) {
+    if (us < 2 * TELEMETRY_SUB_BUCKETS) return (int)us;
+    
+    int msb = 0;
+    for (long long v = us; v > 1; v >>= 1) msb++;
+    
+    int shift = msb - TELEMETRY_SUB_BITS;
+    int index = 2 * TELEMETRY_SUB_BUCKETS + (shift - 1) * TELEMETRY_SUB_BUCKETS +
+                (int)((us >> shift) - TELEMETRY_SUB_BUCKETS);
+    return (index < TELEMETRY_BUCKETS) ? index : TELEMETRY_BUCKETS - 1;
+}
+
+// Middle of the value range a bucket covers
+static double Telemetry_BucketValue(int index) {
+    if (index < 2 * TELEMETRY_SUB_BUCKETS) return (double)index;
+    
+    int shift = (index - 2 * TELEMETRY_SUB_BUCKETS) / TELEMETRY_SUB_BUCKETS + 1;
+    long long sub = (index - 2 * TELEMETRY_SUB_BUCKETS) % TELEMETRY_SUB_BUCKETS + TELEMETRY_SUB_BUCKETS;
+    long long low = sub << shift;
+    long long high = ((sub + 1) << shift) - 1;
+    return (low + high) * 0.5;
+}
+
+static double Telemetry_Percentile(const TelemetryHistogram* histogram, double percentile) {
+    if (histogram->count == 0) return 0.0;
+    
+    long long target = (long long)(percentile / 100.0 * histogram->count + 0.5);
+    if (target < 1) target = 1;
+    
+    long long seen = 0;
+    for (int i = 0; i < TELEMETRY_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= target) {
+            // Never report more than the exact maximum
+            double value = Telemetry_BucketValue(i);
+            return (value < histogram->maxUs) ? value : (double)histogram->maxUs;
+        }
+    }
+    return (double)histogram->maxUs;
+}
+
+void Telemetry_Record(TelemetryMetric metric, long long ns) {
+    if (metric < 0 || metric >= TELEMETRY_METRIC_COUNT || ns < 0) return;
+    
+    TelemetryHistogram* histogram = &histograms[metric];
+    long long us = ns / 1000;
+    
+    histogram->buckets[Telemetry_BucketIndex(us)]++;
+    histogram->count++;
+    histogram->totalUs += us;
+    if (us > histogram->maxUs) histogram->maxUs = us;
+    if (metricBudgetsUs[metric] > 0 && us > metricBudgetsUs[metric]) histogram->overBudget++;
+}
+
+void Telemetry_GetSummary(TelemetryMetric metric, TelemetrySummary* summary) {
+    if (!summary) return;
+    memset(summary, 0, sizeof(*summary));
+    if (metric < 0 || metric >= TELEMETRY_METRIC_COUNT) return;
+    
+    const TelemetryHistogram* histogram = &histograms[metric];
+    summary->count = histogram->count;
+    summary->overBudget = histogram->overBudget;
+    if (histogram->count == 0) return;
+    
+    summary->meanMs = (float)(histogram->totalUs / (double)histogram->count / 1000.0);
+    summary->p50Ms = (float)(Telemetry_Percentile(histogram, 50.0) / 1000.0);
+    summary->p95Ms = (float)(Telemetry_Percentile(histogram, 95.0) / 1000.0);
+    summary->p99Ms = (float)(Telemetry_Percentile(histogram, 99.0) / 1000.0);
+    summary->maxMs = (float)(histogram->maxUs / 1000.0);
+}
+
+const char* Telemetry_GetMetricName(TelemetryMetric metric) {
+    if (metric < 0 || metric >= TELEMETRY_METRIC_COUNT) return "unknown";
+    return metricNames[metric];
+}
+
+void Telemetry_Reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+// Writes telemetry_<time>.csv and .json with one entry per metric
+void Telemetry_WriteSummary(EngineState* engine) {
+    if (!engine) return;
+    if (histograms[TELEMETRY_FRAME].count == 0) return;  // Nothing was played
+    
+    char baseName[64];
+    snprintf(baseName, sizeof(baseName), "telemetry_%ld", (long)time(NULL));
+    
+    TelemetrySummary summaries[TELEMETRY_METRIC_COUNT];
+    for (int i = 0; i < TELEMETRY_METRIC_COUNT; i++) {
+        Telemetry_GetSummary((TelemetryMetric)i, &summaries[i]);
+    }
+    
+    char fileName[128];
+    snprintf(fileName, sizeof(fileName), "%s.csv", baseName);
+    FILE* file = fopen(fileName, "w");
+    if (file) {
+        fprintf(file, "# %s %s, build %s, window %dx%d, internal %dx%d (%s), vsync %s, pacing %s%s, budget %.3fms\n",
+                ENGINE_NAME, ENGINE_VERSION, BUILD_ID, engine->windowWidth, engine->windowHeight,
+                engine->internalWidth, engine->internalHeight, engine->useInternalResolution ? "on" : "off",
+                IsWindowState(FLAG_VSYNC_HINT) ? "on" : "off", Engine_GetPacingName(engine->pacingMode),
+                engine->lateLatch ? " + late latch" : "", TELEMETRY_FRAME_BUDGET_US / 1000.0);
+        fprintf(file, "metric,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,over_budget\n");
+        for (int i = 0; i < TELEMETRY_METRIC_COUNT; i++) {
+            const TelemetrySummary* s = &summaries[i];
+            fprintf(file, "%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f,%lld\n", metricNames[i], s->count,
+                    s->meanMs, s->p50Ms, s->p95Ms, s->p99Ms, s->maxMs, s->overBudget);
+        }
+        fclose(file);
+    } else {
+        TraceLog(LOG_WARNING, "Telemetry: could not open %s", fileName);
+    }
+    
+    snprintf(fileName, sizeof(fileName), "%s.json", baseName);
+    file = fopen(fileName, "w");
+    if (file) {
+        fprintf(file, "{\n  \"engine\": \"%s %s\",\n  \"build\": \"%s\",\n", ENGINE_NAME, ENGINE_VERSION, BUILD_ID);
+        fprintf(file, "  \"pacing\": \"%s\",\n  \"late_latch\": %s,\n", Engine_GetPacingName(engine->pacingMode),
+                engine->lateLatch ? "true" : "false");
+        fprintf(file, "  \"window\": [%d, %d],\n  \"internal\": [%d, %d],\n  \"budget_ms\": %.3f,\n",
+                engine->windowWidth, engine->windowHeight, engine->internalWidth, engine->internalHeight,
+                TELEMETRY_FRAME_BUDGET_US / 1000.0);
+        fprintf(file, "  \"metrics\": {\n");
+        for (int i = 0; i < TELEMETRY_METRIC_COUNT; i++) {
+            const TelemetrySummary* s = &summaries[i];
+            fprintf(file, "    \"%s\": {\"count\": %lld, \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, "
+                    "\"p99_ms\": %.3f, \"max_ms\": %.3f, \"over_budget\": %lld}%s\n", metricNames[i], s->count,
+                    s->meanMs, s->p50Ms, s->p95Ms, s->p99Ms, s->maxMs, s->overBudget,
+                    (i < TELEMETRY_METRIC_COUNT - 1) ? "," : "");
+        }
+        fprintf(file, "  }\n}\n");
+        fclose(file);
+    } else {
+        TraceLog(LOG_WARNING, "Telemetry: could not open %s", fileName);
+    }
+    
+    TraceLog(LOG_INFO, "Telemetry: frame p50 %.2fms p99 %.2fms max %.2fms, %lld over budget (%s.csv/.json)",
+             summaries[TELEMETRY_FRAME].p50Ms, summaries[TELEMETRY_FRAME].p99Ms,
+             summaries[TELEMETRY_FRAME].maxMs, summaries[TELEMETRY_FRAME].overBudget, baseName);
+}
+
+// A steering press starts a probe; each later stage records the time since
+// the press, in order, and the buffer swap closes it. A probe that hasn't
+// been drawn by the next swap (paused, game over) is dropped.
+void Telemetry_StartLatency(EngineState* engine, long long inputNs) {
+    if (!engine || !engine->measureLatency) return;
+    
+    // One probe at a time
+    if (engine->latencyMarks[LATENCY_INPUT] == 0) engine->latencyMarks[LATENCY_INPUT] = inputNs;
+}
+
+void Telemetry_MarkLatency(EngineState* engine, LatencyStage stage) {
+    if (!engine || !engine->measureLatency || stage < 0 || stage >= LATENCY_STAGE_COUNT) return;
+    
+    long long* marks = engine->latencyMarks;
+    long long now = Utils_GetTimeNs();
+    
+    if (stage == LATENCY_INPUT) {
+        Telemetry_StartLatency(engine, now);
+        return;
+    }
+    
+    if (marks[stage - 1] != 0 && marks[stage] == 0) {
+        marks[stage] = now;
+        Telemetry_Record((TelemetryMetric)(TELEMETRY_INPUT_TO_UPDATE + stage - LATENCY_UPDATE),
+                         now - marks[LATENCY_INPUT]);
+    }
+    if (stage == LATENCY_PRESENT) {
+        memset(marks, 0, sizeof(engine->latencyMarks));
+    }
+}
+
+// =====================================
+// Startup Timing
+// =====================================
+
+typedef struct {
+    const char* name;
+    long long ns;
+} StartupPhase;
+
+static StartupPhase startupPhases[STARTUP_MAX_PHASES];
+static int startupPhaseCount = 0;
+static long long startupStartNs = 0;
+static long long startupLastNs = 0;
+
+void Telemetry_BeginStartup(void) {
+    startupStartNs = Utils_GetTimeNs();
+    startupLastNs = startupStartNs;
+    startupPhaseCount = 0;
+}
+
+void Telemetry_MarkStartup(const char* phase) {
+    // Benchmarks never call Telemetry_BeginStartup()
+    if (startupStartNs == 0 || startupPhaseCount >= STARTUP_MAX_PHASES) return;
+    
+    long long now = Utils_GetTimeNs();
+    startupPhases[startupPhaseCount].name = phase;
+    startupPhases[startupPhaseCount].ns = now - startupLastNs;
+    startupPhaseCount++;
+    startupLastNs = now;
+}
+
+void Telemetry_ReportStartup(void) {
+    if (startupStartNs == 0) return;
+    
+    double totalMs = (startupLastNs - startupStartNs) / 1000000.0;
+    printf("STARTUP build=%s\n", BUILD_ID);
+    for (int i = 0; i < startupPhaseCount; i++) {
+        double ms = startupPhases[i].ns / 1000000.0;
+        printf("  %-20s %8.2fms %5.1f%%\n", startupPhases[i].name, ms,
+               totalMs > 0.0 ? ms * 100.0 / totalMs : 0.0);
+    }
+    printf("  %-20s %8.2fms (target %.0fms%s)\n", "total", totalMs, STARTUP_TARGET_MS,
+           totalMs <= STARTUP_TARGET_MS ? "" : ", MISSED");
+}
@@ -0,0 +1,279 @@
+#include "engine.h"
+#include <rlgl.h>
+#include <stdio.h>
+#include <string.h>
+
+// =====================================
+// Text Layout Cache Implementation
+// =====================================
+
+// Layouts are keyed by string and font size. HUD strings are mostly static,
+// so after the first frame drawing one is a hash lookup plus quad emission.
+// Layouts live in a fixed pool and never move; the hash index only holds pool
+// slots, so evicting one entry leaves every other layout where it was.
+typedef struct {
+    unsigned int hash;
+    unsigned int lastUsedFrame;
+    TextLayout layout;
+} TextCacheEntry;
+
+#define TEXT_CACHE_CAPACITY (TEXT_CACHE_SIZE * 3 / 4)  // Keeps probe chains short
+
+static TextCacheEntry textCache[TEXT_CACHE_CAPACITY];
+static short textIndex[TEXT_CACHE_SIZE];   // Pool slot + 1, 0 for an empty bucket
+static int textCacheCount = 0;
+static int textLayoutsThisFrame = 0;
+static unsigned int textFrame = 1;
+static TextLayout textScratch;             // Overflow when every entry was used this frame
+
+// FNV-1a over the string, mixed with the font size
+static unsigned int Text_Hash(const char* text, int fontSize) {
+    unsigned int hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    hash ^= (unsigned int)fontSize;
+    hash *= 16777619u;
+    return hash;
+}
+
+// Lay out a single line exactly like DrawText() would draw it
+static void Text_BuildLayout(TextLayout* layout, const char* text, int fontSize) {
+    Font font = GetFontDefault();
+
+    // DrawText() clamps small sizes to the default font height
+    int drawSize = (fontSize < 10) ? 10 : fontSize;
+    float spacing = (float)(drawSize / 10);
+    float scale = (float)drawSize / font.baseSize;
+    float padding = (float)font.glyphPadding;
+
+    strncpy(layout->text, text, TEXT_MAX_LENGTH - 1);
+    layout->text[TEXT_MAX_LENGTH - 1] = '\0';
+    layout->fontSize = fontSize;
+    layout->glyphCount = 0;
+
+    float penX = 0.0f;
+    float advanceSum = 0.0f;
+    int codepointCount = 0;
+
+    for (int i = 0; layout->text[i] != '\0';) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&layout->text[i], &codepointSize);
+        int index = GetGlyphIndex(font, codepoint);
+        Rectangle rec = font.recs[index];
+        float advance = (font.glyphs[index].advanceX == 0) ? rec.width : (float)font.glyphs[index].advanceX;
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            TextGlyphQuad* quad = &layout->glyphs[layout->glyphCount++];
+            quad->u0 = (rec.x - padding) / font.texture.width;
+            quad->v0 = (rec.y - padding) / font.texture.height;
+            quad->u1 = (rec.x + rec.width + padding) / font.texture.width;
+            quad->v1 = (rec.y + rec.height + padding) / font.texture.height;
+            quad->x = penX + (font.glyphs[index].offsetX - padding) * scale;
+            quad->y = (font.glyphs[index].offsetY - padding) * scale;
+            quad->width = (rec.width + 2.0f * padding) * scale;
+            quad->height = (rec.height + 2.0f * padding) * scale;
+        }
+
+        penX += advance * scale + spacing;
+        advanceSum += advance;
+        codepointCount++;
+        i += codepointSize;
+    }
+
+    // Same formula as MeasureTextEx(): advances plus spacing between glyphs
+    layout->width = (codepointCount > 0) ? (int)(advanceSum * scale + (codepointCount - 1) * spacing) : 0;
+    textLayoutsThisFrame++;
+}
+
+// Empty a bucket and shift later entries of its probe chain back into the gap
+static void Text_RemoveBucket(unsigned int bucket) {
+    unsigned int mask = TEXT_CACHE_SIZE - 1;
+    unsigned int hole = bucket;
+    textIndex[hole] = 0;
+
+    for (unsigned int next = (hole + 1) & mask; textIndex[next] != 0; next = (next + 1) & mask) {
+        unsigned int home = textCache[textIndex[next] - 1].hash & mask;
+
+        // The entry can fill the hole unless its home lies cyclically in (hole, next]
+        bool reachable = (hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (reachable) {
+            textIndex[hole] = textIndex[next];
+            textIndex[next] = 0;
+            hole = next;
+        }
+    }
+}
+
+// Pool slot for a new layout: a free one, else the least recently drawn entry
+// that wasn't used this frame. -1 when every entry was drawn this frame.
+static int Text_AllocateEntry(void) {
+    if (textCacheCount < TEXT_CACHE_CAPACITY) return textCacheCount++;
+
+    int oldest = -1;
+    for (int i = 0; i < TEXT_CACHE_CAPACITY; i++) {
+        if (textCache[i].lastUsedFrame == textFrame) continue;
+        if (oldest < 0 || textCache[i].lastUsedFrame < textCache[oldest].lastUsedFrame) oldest = i;
+    }
+    if (oldest < 0) return -1;
+
+    unsigned int mask = TEXT_CACHE_SIZE - 1;
+    unsigned int bucket = textCache[oldest].hash & mask;
+    while (textIndex[bucket] != oldest + 1) bucket = (bucket + 1) & mask;
+    Text_RemoveBucket(bucket);
+    return oldest;
+}
+
+// The returned layout stays valid until the next Text_BeginFrame(): entries
+// drawn in the current frame are never evicted. Past TEXT_CACHE_CAPACITY
+// distinct strings in one frame, the extra ones share a scratch layout that
+// only lasts until the next such call.
+const TextLayout* Text_Layout(const char* text, int fontSize) {
+    if (!text) text = "";
+
+    unsigned int hash = Text_Hash(text, fontSize);
+    unsigned int mask = TEXT_CACHE_SIZE - 1;
+
+    // Linear probing; strings too long for a slot are truncated consistently
+    unsigned int bucket = hash & mask;
+    for (; textIndex[bucket] != 0; bucket = (bucket + 1) & mask) {
+        TextCacheEntry* entry = &textCache[textIndex[bucket] - 1];
+        if (entry->hash == hash && entry->layout.fontSize == fontSize &&
+            strncmp(entry->layout.text, text, TEXT_MAX_LENGTH - 1) == 0) {
+            entry->lastUsedFrame = textFrame;
+            return &entry->layout;
+        }
+    }
+
+    int slot = Text_AllocateEntry();
+    if (slot < 0) {
+        Text_BuildLayout(&textScratch, text, fontSize);
+        return &textScratch;
+    }
+
+    // Eviction may have shifted the chain, so find the first empty bucket again
+    bucket = hash & mask;
+    while (textIndex[bucket] != 0) bucket = (bucket + 1) & mask;
+
+    TextCacheEntry* entry = &textCache[slot];
+    entry->hash = hash;
+    entry->lastUsedFrame = textFrame;
+    Text_BuildLayout(&entry->layout, text, fontSize);
+    textIndex[bucket] = (short)(slot + 1);
+    return &entry->layout;
+}
+
+const TextLayout* Text_LayoutInt(TextField* field, const char* format, int value, int fontSize) {
+    if (!field->valid || field->value != (double)value || field->layout.fontSize != fontSize) {
+        char buffer[TEXT_MAX_LENGTH];
+        snprintf(buffer, sizeof(buffer), format, value);
+        Text_BuildLayout(&field->layout, buffer, fontSize);
+        field->value = (double)value;
+        field->valid = true;
+    }
+    return &field->layout;
+}
+
+const TextLayout* Text_LayoutFloat(TextField* field, const char* format, float value, int fontSize) {
+    if (!field->valid || field->value != (double)value || field->layout.fontSize != fontSize) {
+        char buffer[TEXT_MAX_LENGTH];
+        snprintf(buffer, sizeof(buffer), format, value);
+        field->value = (double)value;
+
+        // Values often change below the printed precision; keep the layout
+        if (!field->valid || field->layout.fontSize != fontSize ||
+            strcmp(buffer, field->layout.text) != 0) {
+            Text_BuildLayout(&field->layout, buffer, fontSize);
+        }
+        field->valid = true;
+    }
+    return &field->layout;
+}
+
+// For lines built from several values: only re-laid out when the text changes,
+// and never stored in the shared cache, so changing HUD lines can't evict it
+const TextLayout* Text_LayoutString(TextField* field, const char* text, int fontSize) {
+    if (!text) text = "";
+    if (!field->valid || field->layout.fontSize != fontSize ||
+        strncmp(field->layout.text, text, TEXT_MAX_LENGTH - 1) != 0) {
+        Text_BuildLayout(&field->layout, text, fontSize);
+        field->valid = true;
+    }
+    return &field->layout;
+}
+
+// Lets multi-value lines skip formatting: compare the values the line is
+// built from and only call TextFormat() + Text_LayoutString() when they moved
+bool Text_FieldChanged(TextField* field, const double* keys, int count, int fontSize) {
+    if (count > TEXT_FIELD_KEYS) count = TEXT_FIELD_KEYS;
+
+    bool changed = !field->valid || field->layout.fontSize != fontSize || field->keyCount != count;
+    for (int i = 0; i < count && !changed; i++) {
+        changed = field->keys[i] != keys[i];
+    }
+    if (changed) {
+        memcpy(field->keys, keys, sizeof(double) * count);
+        field->keyCount = count;
+    }
+    return changed;
+}
+
+// Emit the layout's quads into the current rlgl batch. Every call uses the
+// default font texture (which is also raylib's shapes texture), so the whole
+// HUD stays in a single batched quad stream.
+void Text_DrawLayout(const TextLayout* layout, int posX, int posY, Color color) {
+    if (!layout || layout->glyphCount == 0) return;
+
+    Font font = GetFontDefault();
+    if (font.texture.id == 0) return;
+
+    rlCheckRenderBatchLimit(4 * layout->glyphCount);
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < layout->glyphCount; i++) {
+        const TextGlyphQuad* quad = &layout->glyphs[i];
+        float x0 = posX + quad->x;
+        float y0 = posY + quad->y;
+        float x1 = x0 + quad->width;
+        float y1 = y0 + quad->height;
+
+        rlTexCoord2f(quad->u0, quad->v0);
+        rlVertex2f(x0, y0);
+        rlTexCoord2f(quad->u0, quad->v1);
+        rlVertex2f(x0, y1);
+        rlTexCoord2f(quad->u1, quad->v1);
+        rlVertex2f(x1, y1);
+        rlTexCoord2f(quad->u1, quad->v0);
+        rlVertex2f(x1, y0);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void Text_Draw(const char* text, int posX, int posY, int fontSize, Color color) {
+    Text_DrawLayout(Text_Layout(text, fontSize), posX, posY, color);
+}
+
+void Text_DrawCentered(const char* text, int centerX, int posY, int fontSize, Color color) {
+    const TextLayout* layout = Text_Layout(text, fontSize);
+    Text_DrawLayout(layout, centerX - layout->width / 2, posY, color);
+}
+
+int Text_Measure(const char* text, int fontSize) {
+    return Text_Layout(text, fontSize)->width;
+}
+
+void Text_BeginFrame(void) {
+    textLayoutsThisFrame = 0;
+    textFrame++;
+}
+
+void Text_GetStats(int* cached, int* layoutsThisFrame) {
+    if (cached) *cached = textCacheCount;
+    if (layoutsThisFrame) *layoutsThisFrame = textLayoutsThisFrame;
+}
@@ -1,5 +1,26 @@
+// clock_gettime() is POSIX, not C99
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "engine.h"
 #include <math.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+// Declared directly because windows.h clashes with raylib names
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long* count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long* frequency);
+__declspec(dllimport) unsigned long __stdcall GetCurrentThreadId(void);
+__declspec(dllimport) void* __stdcall CreateThread(void* attributes, size_t stackSize,
+                                                   unsigned long (__stdcall *start)(void*),
+                                                   void* param, unsigned long flags, unsigned long* threadId);
+__declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void* handle, unsigned long milliseconds);
+__declspec(dllimport) int __stdcall CloseHandle(void* handle);
+#else
+#include <time.h>
+#include <pthread.h>
+#endif
 
 // =====================================
 // Control Groups Implementation
@@ -15,18 +36,16 @@ void ControlGroup_Assign(EngineState* engine, int groupId) {
     Vector3 centerSum = {0, 0, 0};
     int count = 0;
     
-    // Add selected entities to group
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (engine->entities[i].active && engine->entities[i].selected) {
-            if (group->entityCount < MAX_ENTITIES) {
-                // Remove from other groups
-                engine->entities[i].groupId = groupId;
-                group->entityIds[group->entityCount++] = engine->entities[i].id;
-                
-                centerSum = Vector3Add(centerSum, engine->entities[i].position);
-                count++;
-            }
-        }
+    // Add selected entities to group, up to its capacity
+    for (int i = 0; i < engine->selectedCount && group->entityCount < MAX_CONTROL_GROUP_SIZE; i++) {
+        Entity* entity = &engine->entities[engine->selection[i]];
+        
+        // Remove from other groups
+        entity->groupId = groupId;
+        group->entityIds[group->entityCount++] = entity->id;
+        
+        centerSum = Vector3Add(centerSum, entity->position);
+        count++;
     }
     
     if (count > 0) {
@@ -51,7 +70,7 @@ void ControlGroup_Select(EngineState* engine, int groupId) {
     for (int i = 0; i < group->entityCount; i++) {
         Entity* entity = Entity_GetById(engine, group->entityIds[i]);
         if (entity && entity->active) {
-            entity->selected = true;
+            Entity_Select(engine, entity, true);
             centerSum = Vector3Add(centerSum, entity->position);
             validCount++;
         }
@@ -75,10 +94,11 @@ void ControlGroup_Clear(EngineState* engine, int groupId) {
     
     ControlGroup* group = &engine->controlGroups[groupId];
     
-    // Clear group assignment from entities
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (engine->entities[i].active && engine->entities[i].groupId == groupId) {
-            engine->entities[i].groupId = 0;
+    // Clear group assignment from its members that haven't joined another group since
+    for (int i = 0; i < group->entityCount; i++) {
+        Entity* entity = Entity_GetById(engine, group->entityIds[i]);
+        if (entity && entity->groupId == groupId) {
+            entity->groupId = 0;
         }
     }
     
@@ -107,8 +127,9 @@ Vector3 Utils_GetGroundPosition(Vector3 worldPos) {
 Vector3 Utils_ScreenToWorld(EngineState* engine, Vector2 screenPos) {
     if (!engine) return (Vector3){0, 0, 0};
     
-    // Create a ray from screen position
-    Ray ray = GetMouseRay(screenPos, engine->camera);
+    // Create a ray from a position on the UI canvas (see Input_Update)
+    Ray ray = GetScreenToWorldRayEx(screenPos, engine->camera,
+                                    Engine_GetUIWidth(engine), Engine_GetUIHeight(engine));
     
     // Intersect with ground plane (Y=0)
     float t = -ray.position.y / ray.direction.y;
@@ -121,8 +142,46 @@ Vector3 Utils_ScreenToWorld(EngineState* engine, Vector2 screenPos) {
 }
 
 Vector2 Utils_WorldToScreen(EngineState* engine, Vector3 worldPos) {
-    if (!engine) return (Vector2){0, 0};
-    return GetWorldToScreen(worldPos, engine->camera);
+    Vector2 screenPos = {0, 0};
+    Utils_WorldToScreenBatch(engine, &worldPos, 1, &screenPos);
+    return screenPos;
+}
+
+// Projects onto the UI canvas with the matrices from Camera_Apply(), giving
+// the same results as GetWorldToScreenEx(). The viewport transform is folded
+// into the matrix rows, so each point costs three dot products and a divide
+// in a loop the compiler can vectorize. Points behind the camera come out
+// mirrored, as with raylib.
+void Utils_WorldToScreenBatch(EngineState* engine, const Vector3* points, int count, Vector2* out) {
+    if (!engine || !points || !out) return;
+    
+    // Matrices are only published once Camera_Apply() has run
+    if (engine->cameraMatrices.width <= 0) Camera_Apply(engine);
+    if (engine->cameraMatrices.width <= 0 || engine->cameraMatrices.height <= 0) {
+        for (int i = 0; i < count; i++) out[i] = (Vector2){ 0, 0 };
+        return;
+    }
+    
+    // raymath matrices are column-major: row r of the product is (m[r], m[r+4], m[r+8], m[r+12])
+    const Matrix* m = &engine->cameraMatrices.viewProjection;
+    const float halfWidth = engine->cameraMatrices.width * 0.5f;
+    const float halfHeight = engine->cameraMatrices.height * 0.5f;
+    
+    // Screen x = (clip.x / clip.w + 1) * halfWidth, screen y = (1 - clip.y / clip.w) * halfHeight
+    const float xx = halfWidth * (m->m0 + m->m3), xy = halfWidth * (m->m4 + m->m7);
+    const float xz = halfWidth * (m->m8 + m->m11), xw = halfWidth * (m->m12 + m->m15);
+    const float yx = halfHeight * (m->m3 - m->m1), yy = halfHeight * (m->m7 - m->m5);
+    const float yz = halfHeight * (m->m11 - m->m9), yw = halfHeight * (m->m15 - m->m13);
+    const float wx = m->m3, wy = m->m7, wz = m->m11, ww = m->m15;
+    
+    for (int i = 0; i < count; i++) {
+        float x = points[i].x;
+        float y = points[i].y;
+        float z = points[i].z;
+        float invW = 1.0f / (wx * x + wy * y + wz * z + ww);
+        out[i].x = (xx * x + xy * y + xz * z + xw) * invW;
+        out[i].y = (yx * x + yy * y + yz * z + yw) * invW;
+    }
 }
 
 bool Utils_IsPointInBox(Vector2 point, Vector2 boxStart, Vector2 boxEnd) {
@@ -135,6 +194,91 @@ bool Utils_IsPointInBox(Vector2 point, Vector2 boxStart, Vector2 boxEnd) {
             point.y >= minY && point.y <= maxY);
 }
 
+long long Utils_GetTimeNs(void) {
+#if defined(_WIN32)
+    static long long frequency = 0;
+    long long count;
+    if (frequency == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    
+    // Split to avoid overflowing count * 1e9
+    return (count / frequency) * 1000000000LL + (count % frequency) * 1000000000LL / frequency;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+unsigned long Utils_GetThreadId(void) {
+#if defined(_WIN32)
+    return GetCurrentThreadId();
+#else
+    return (unsigned long)pthread_self();
+#endif
+}
+
+struct UtilsThread {
+    void (*func)(void* arg);
+    void* arg;
+#if defined(_WIN32)
+    void* handle;
+#else
+    pthread_t handle;
+#endif
+};
+
+// Adapts the portable entry point to each platform's thread signature
+#if defined(_WIN32)
+static unsigned long __stdcall Utils_ThreadEntry(void* param) {
+    UtilsThread* thread = (UtilsThread*)param;
+    thread->func(thread->arg);
+    return 0;
+}
+#else
+static void* Utils_ThreadEntry(void* param) {
+    UtilsThread* thread = (UtilsThread*)param;
+    thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+UtilsThread* Utils_StartThread(void (*func)(void* arg), void* arg) {
+    if (!func) return NULL;
+    
+    UtilsThread* thread = (UtilsThread*)malloc(sizeof(UtilsThread));
+    if (!thread) return NULL;
+    thread->func = func;
+    thread->arg = arg;
+    
+#if defined(_WIN32)
+    thread->handle = CreateThread(NULL, 0, Utils_ThreadEntry, thread, 0, NULL);
+    if (!thread->handle) {
+        free(thread);
+        return NULL;
+    }
+#else
+    if (pthread_create(&thread->handle, NULL, Utils_ThreadEntry, thread) != 0) {
+        free(thread);
+        return NULL;
+    }
+#endif
+    
+    return thread;
+}
+
+void Utils_JoinThread(UtilsThread* thread) {
+    if (!thread) return;
+    
+#if defined(_WIN32)
+    WaitForSingleObject(thread->handle, 0xFFFFFFFFul);  // INFINITE
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
 bool Utils_CheckCollisionSpheres(Vector3 pos1, float radius1, Vector3 pos2, float radius2) {
     float distance = Vector3Distance(pos1, pos2);
     return distance <= (radius1 + radius2);